@@ -0,0 +1,177 @@
+/*
+  ==============================================================================
+
+    BatchBench.cpp
+    Created: 20 Oct 2026 12:41:09am
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#include <cstdio>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "Benchmarks.h"
+#include "BatchEngine.h"
+#include "Compressor.h"
+#include "Crossover.h"
+#include "defines.h"
+
+// Many mono streams through the batched engine against one scalar chain
+// (Crossover at 6 dB/oct and four Compressors, no lookahead) per stream.
+// Halfway through, every other stream is removed and a fresh one added in
+// its place; the streams that stay must not notice.
+namespace
+{
+    struct ScalarStream {
+        StreamSettings s;
+        CrossoverParameters split;
+        CompressorParameters band[4];
+        Crossover crossover;
+        Compressor comps[4];
+        std::vector<float> bands[3], gains[4];
+        float* bandPtr[3];
+
+        void prepare(double fs, int blockSize)
+        {
+            split = { s.f0, s.f1, SLOPE_6 };
+            crossover.setParameters(&split);
+            crossover.setfs((float)fs);
+            for (int b = 0; b < 4; b++)
+            {
+                band[b] = { s.at[b], s.rt[b], 0.0f, s.CT[b], s.CR[b] };
+                comps[b].setParameters(&band[b]);
+                comps[b].setfs(fs);
+                gains[b].resize(blockSize);
+                if (b < 3)
+                {
+                    bands[b].resize(blockSize);
+                    bandPtr[b] = bands[b].data();
+                }
+            }
+        }
+        void process(float* x, int n)
+        {
+            auto gain = [](float db) { return db == 0 ? 1.0f : fastmath::fast_db_to_gain(db); };
+
+            crossover.process(x, bandPtr, n);
+            for (int i = 0; i < n; i++)
+                x[i] = 0;
+            for (int band = 0; band < 3; band++)
+            {
+                for (int i = 0; i < n; i++)
+                    bands[band][i] *= gain(s.pre[band]);
+                comps[band].setInputBuffer(bandPtr[band]);
+                comps[band].setGainBuffer(gains[band].data());
+                comps[band].process(n);
+                for (int i = 0; i < n; i++)
+                    x[i] += bands[band][i] * gains[band][i] * gain(s.post[band]);
+            }
+            for (int i = 0; i < n; i++)
+                x[i] *= gain(s.pre[MAS]);
+            comps[MAS].setInputBuffer(x);
+            comps[MAS].setGainBuffer(gains[MAS].data());
+            comps[MAS].process(n);
+            for (int i = 0; i < n; i++)
+                x[i] *= gains[MAS][i] * gain(s.post[MAS]);
+        }
+    };
+
+    StreamSettings settingsFor(int stream)
+    {
+        StreamSettings s;
+        for (int band = 0; band < 4; band++)
+        {
+            s.CT[band] = -20.0f - (stream % 7) * 3.0f;
+            s.CR[band] = 2.0f + (stream % 5);
+            s.at[band] = 1.0f + band;
+            s.rt[band] = 40.0f + 20 * band;
+        }
+        s.pre[MID] = 3.0f;
+        s.post[MAS] = 2.0f;
+        s.f0 = 150.0f + 10 * (stream % 11);
+        s.f1 = 3000.0f;
+        return s;
+    }
+}
+
+int runBatchBench()
+{
+    const double fs = 48000;
+    const int blockSize = 256;
+    const int numStreams = 1024;
+    const auto program = makeProgram(fs, 2);
+    const int length = (int)program.size() / blockSize * blockSize;
+
+    BatchEngine engine(numStreams, fs);
+    std::vector<std::unique_ptr<ScalarStream>> scalar(numStreams);
+    std::vector<int> ids(numStreams);
+    for (int k = 0; k < numStreams; k++)
+    {
+        scalar[k] = std::make_unique<ScalarStream>();
+        scalar[k]->s = settingsFor(k);
+        scalar[k]->prepare(fs, blockSize);
+        ids[k] = engine.addStream(1, scalar[k]->s);
+    }
+
+    // every stream reads the program from its own offset
+    std::vector<float> batchData((size_t)numStreams * blockSize), scalarData((size_t)numStreams * blockSize);
+    std::vector<float*> channel(numStreams);
+    std::vector<float* const*> streams(engine.getMaxStreams(), nullptr);
+
+    double batchTime = 0, scalarTime = 0, maxError = 0, maxErrorKept = 0;
+    int removed = 0;
+    for (int pos = 0; pos < length; pos += blockSize)
+    {
+        if (pos == length / 2 / blockSize * blockSize)
+        {
+            // churn: the odd streams start over
+            for (int k = 1; k < numStreams; k += 2)
+            {
+                engine.removeStream(ids[k]);
+                scalar[k] = std::make_unique<ScalarStream>();
+                scalar[k]->s = settingsFor(k + numStreams);
+                scalar[k]->prepare(fs, blockSize);
+                ids[k] = engine.addStream(1, scalar[k]->s);
+                removed++;
+            }
+        }
+
+        for (int k = 0; k < numStreams; k++)
+        {
+            float* b = batchData.data() + (size_t)k * blockSize;
+            float* s = scalarData.data() + (size_t)k * blockSize;
+            for (int i = 0; i < blockSize; i++)
+                b[i] = s[i] = program[(pos + i + 977 * k) % length];
+            channel[k] = b;
+            streams[ids[k]] = &channel[k];
+        }
+
+        auto start = juce::Time::getHighResolutionTicks();
+        engine.process(streams.data(), blockSize);
+        batchTime += secondsSince(start);
+
+        start = juce::Time::getHighResolutionTicks();
+        for (int k = 0; k < numStreams; k++)
+            scalar[k]->process(scalarData.data() + (size_t)k * blockSize, blockSize);
+        scalarTime += secondsSince(start);
+
+        for (int k = 0; k < numStreams; k++)
+            for (int i = 0; i < blockSize; i++)
+            {
+                const double error = std::abs(batchData[(size_t)k * blockSize + i] - scalarData[(size_t)k * blockSize + i]);
+                maxError = juce::jmax(maxError, error);
+                if (k % 2 == 0)
+                    maxErrorKept = juce::jmax(maxErrorKept, error);
+            }
+    }
+
+    const double samples = (double)numStreams * length;
+    std::printf("%d mono streams, %.1f s each, %d restarted halfway\n", numStreams, length / fs, removed);
+    std::printf("%-10s %14s %12s\n", "path", "ns/sample", "x realtime");
+    std::printf("%-10s %14.2f %12.0f\n", "scalar", scalarTime * 1e9 / samples, samples / fs / scalarTime);
+    std::printf("%-10s %14.2f %12.0f\n", "batched", batchTime * 1e9 / samples, samples / fs / batchTime);
+    std::printf("speedup %.2f, max deviation %.2e (streams kept through the churn %.2e), free lanes %d\n",
+        scalarTime / batchTime, maxError, maxErrorKept, engine.getNumFreeLanes());
+
+    return maxError < 1e-3 ? 0 : 1;
+}
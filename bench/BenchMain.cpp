@@ -0,0 +1,53 @@
+/*
+  ==============================================================================
+
+    BenchMain.cpp
+    Created: 19 Oct 2026 3:05:40pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#include <cstdio>
+#include <cstring>
+#include "Benchmarks.h"
+
+static const struct { const char* name; int (*run)(); const char* description; } benchmarks[] =
+{
+    { "controlrate", runControlRateBench, "compressor gain computer rate vs. full rate null test" },
+    { "multirate",   runMultirateBench,   "low band detector at decimated rates vs. full rate" },
+    { "crossover",   runCrossoverBench,   "serial allpass split vs. biquad crossover at every slope" },
+    { "fastmath",    runFastMathBench,    "fastmath accuracy against libm and speed" },
+    { "kernels",     runKernelsBench,     "every kernel instruction set the CPU runs vs. the baseline" },
+    { "batch",       runBatchBench,       "batched multi-stream engine vs. one scalar chain per stream" },
+};
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::printf("usage: MBCompBench <name>|all\n\n");
+        for (const auto& b : benchmarks)
+            std::printf("  %-14s %s\n", b.name, b.description);
+        return 1;
+    }
+
+    int result = 0;
+    bool found = false;
+    for (const auto& b : benchmarks)
+    {
+        if (std::strcmp(argv[1], "all") != 0 && std::strcmp(argv[1], b.name) != 0)
+            continue;
+
+        std::printf("== %s ==\n", b.name);
+        result |= b.run();
+        found = true;
+    }
+
+    if (!found)
+    {
+        std::printf("unknown benchmark: %s\n", argv[1]);
+        return 1;
+    }
+    return result;
+}
@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    Benchmarks.h
+    Created: 19 Oct 2026 3:05:40pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <vector>
+
+//==============================================================================
+// every benchmark returns 0 on success
+int runControlRateBench();
+int runMultirateBench();
+int runCrossoverBench();
+int runFastMathBench();
+int runKernelsBench();
+int runBatchBench();
+// MBCompEditorBench
+int runEditorPaintBench();
+int runStartupBench();
+int runEventsBench();
+
+//==============================================================================
+inline double secondsSince(juce::int64 startTicks)
+{
+    return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+}
+
+// Noise bursts with fast attacks and slow decays, loud enough to keep the
+// compressors working. Deterministic, so runs are comparable.
+inline std::vector<float> makeProgram(double sampleRate, double seconds)
+{
+    std::vector<float> x((size_t)(sampleRate * seconds));
+    juce::Random random(1);
+    double env = 0;
+
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        double t = i / sampleRate;
+        if (std::fmod(t, 0.25) < 1.0 / sampleRate)
+            env = 0.2 + 0.8 * random.nextDouble();
+        env *= std::exp(-8.0 / sampleRate);
+        x[i] = (float)(env * (2 * random.nextDouble() - 1));
+    }
+    return x;
+}
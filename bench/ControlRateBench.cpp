@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    ControlRateBench.cpp
+    Created: 19 Oct 2026 3:12:08pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#include <cstdio>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "Benchmarks.h"
+#include "Compressor.h"
+#include "defines.h"
+
+// Runs the same program through one compressor at every gain computer
+// interval and compares the result with the full rate render.
+int runControlRateBench()
+{
+    const double fs = 48000;
+    const int blockSize = 512;
+    const auto x = makeProgram(fs, 30);
+    const int length = (int)x.size();
+
+    CompressorParameters params;
+    params.at = 1.0f;
+    params.rt = 80.0f;
+    params.la = 5.0f;
+    params.CT = -30.0f;
+    params.CR = 4.0f;
+
+    auto render = [&](int interval, bool cubic, std::vector<float>& gain)
+        {
+            Compressor comp;
+            comp.setParameters(&params);
+            comp.setfs(fs);
+            comp.setInterval(interval, cubic);
+
+            gain.resize(x.size());
+            auto start = juce::Time::getHighResolutionTicks();
+            for (int pos = 0; pos < length; pos += blockSize)
+            {
+                comp.setInputBuffer(const_cast<float*>(x.data()) + pos);
+                comp.setGainBuffer(gain.data() + pos);
+                comp.process(juce::jmin(blockSize, length - pos));
+            }
+            return secondsSince(start);
+        };
+
+    std::vector<float> reference, gain;
+    const double refTime = render(1, false, reference);
+
+    std::printf("%-8s %-7s %10s %8s %14s %14s\n", "interval", "interp", "ns/sample", "speedup", "max dev [dB]", "null [dBFS]");
+    std::printf("%-8d %-7s %10.2f %8.2f %14s %14s\n", 1, "-", refTime * 1e9 / length, 1.0, "-", "-");
+
+    for (int interval : { 4, 8, 16, 32 })
+    {
+        for (bool cubic : { false, true })
+        {
+            const double time = render(interval, cubic, gain);
+
+            // deviation of the gain curve and residual of the null test
+            double maxDev = 0, residual = 0;
+            for (int i = 0; i < length; i++)
+            {
+                double dev = std::abs(juce::Decibels::gainToDecibels((double)gain[i], -200.0)
+                                    - juce::Decibels::gainToDecibels((double)reference[i], -200.0));
+                maxDev = juce::jmax(maxDev, dev);
+
+                double diff = x[i] * (gain[i] - reference[i]);
+                residual += diff * diff;
+            }
+            residual = std::sqrt(residual / length);
+
+            std::printf("%-8d %-7s %10.2f %8.2f %14.3f %14.1f\n", interval, cubic ? "cubic" : "linear",
+                time * 1e9 / length, refTime / time, maxDev,
+                juce::Decibels::gainToDecibels(residual, -200.0));
+        }
+    }
+    return 0;
+}
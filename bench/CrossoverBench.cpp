@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+
+    CrossoverBench.cpp
+    Created: 19 Oct 2026 6:40:15pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#include <complex>
+#include <cstdio>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "Benchmarks.h"
+#include "Allpass.h"
+#include "Crossover.h"
+#include "CircularBuffer.h"
+#include "defines.h"
+
+// Cost of the band split: the serial first order allpass chain the plugin
+// used to run against the biquad engine at every slope. "with delays" adds
+// the lookahead of the three bands (defla), the split stage of the plugin
+// per channel, then and now. "stereo / ch" is the two channel pass of the
+// stereo layout, per channel. The sum error is the largest deviation of the
+// summed bands' magnitude from 1.
+int runCrossoverBench()
+{
+    const double fs = 48000;
+    const int blockSize = 512;
+    const auto x = makeProgram(fs, 30);
+    const int length = (int)x.size();
+
+    // plain values, the slope as a choice index
+    CrossoverParameters split;
+    split.f0 = 200.0f;
+    split.f1 = 2000.0f;
+
+    std::vector<float> storage[3];
+    for (auto& band : storage)
+        band.resize(blockSize);
+    float* bands[3] = { storage[0].data(), storage[1].data(), storage[2].data() };
+    std::vector<float> storageR[3];
+    for (auto& band : storageR)
+        band.resize(blockSize);
+    float* bandsR[3] = { storageR[0].data(), storageR[1].data(), storageR[2].data() };
+    float** stereoBands[2] = { bands, bandsR };
+
+    // the band lookahead delays, in place
+    const int lookahead = (int)(defla * fs / 1000);
+    CircularBuffer<float> delays[3];
+    for (auto& delay : delays)
+        delay.resize(lookahead);
+    auto delayBands = [&](int n)
+        {
+            for (int band = 0; band < 3; band++)
+                delays[band].push(bands[band], bands[band], n);
+        };
+
+    // serial chain: the high band is filtered from the mid band
+    Allpass chain[2];
+    chain[0].setfc(&split.f0);
+    chain[1].setfc(&split.f1);
+    for (auto& a : chain)
+        a.setfs((float)fs);
+
+    auto serial = [&](bool delayed)
+        {
+            auto start = juce::Time::getHighResolutionTicks();
+            for (int pos = 0; pos < length; pos += blockSize)
+            {
+                const int n = juce::jmin(blockSize, length - pos);
+                const float* in = x.data() + pos;
+                for (int i = 0; i < n; i++)
+                {
+                    bands[LOW][i] = in[i];
+                    bands[MID][i] = in[i];
+                }
+                chain[0].setIn(const_cast<float*>(in));
+                chain[0].setOut(bands[LOW]);
+                chain[0].setNeg(bands[MID]);
+                chain[1].setIn(bands[MID]);
+                chain[1].setOut(bands[MID]);
+                chain[1].setNeg(bands[HHI]);
+
+                chain[0].process(n);
+                for (int i = 0; i < n; i++)
+                {
+                    bands[LOW][i] /= 2;
+                    bands[HHI][i] = (bands[MID][i] /= 2);
+                }
+                chain[1].process(n);
+                for (int i = 0; i < n; i++)
+                {
+                    bands[MID][i] /= 2;
+                    bands[HHI][i] /= 2;
+                }
+                if (delayed)
+                    delayBands(n);
+            }
+            return secondsSince(start);
+        };
+    const double refTime = serial(false);
+    const double refDelayed = serial(true);
+
+    std::printf("%-14s %8s %10s %8s %14s %12s %14s\n", "crossover", "stages", "ns/sample", "speedup", "with delays",
+        "stereo / ch", "sum err [dB]");
+    std::printf("%-14s %8d %10.2f %8.2f %14.2f %12s %14s\n", "serial 6 dB", 2, refTime * 1e9 / length, 1.0,
+        refDelayed * 1e9 / length, "-", "-");
+
+    static const char* names[] = { "biquad 6 dB", "LR2", "LR4", "LR8" };
+    for (int order = SLOPE_6; order <= SLOPE_LR8; order++)
+    {
+        split.slope = (float)order;
+        Crossover crossover;
+        crossover.setParameters(&split);
+        crossover.setfs((float)fs);
+
+        auto start = juce::Time::getHighResolutionTicks();
+        for (int pos = 0; pos < length; pos += blockSize)
+            crossover.process(x.data() + pos, bands, juce::jmin(blockSize, length - pos));
+        const double time = secondsSince(start);
+
+        start = juce::Time::getHighResolutionTicks();
+        for (int pos = 0; pos < length; pos += blockSize)
+        {
+            const int n = juce::jmin(blockSize, length - pos);
+            crossover.process(x.data() + pos, bands, n);
+            delayBands(n);
+        }
+        const double timeDelayed = secondsSince(start);
+
+        start = juce::Time::getHighResolutionTicks();
+        for (int pos = 0; pos < length; pos += blockSize)
+        {
+            const float* in[2] = { x.data() + pos, x.data() + pos };
+            crossover.process(in, stereoBands, juce::jmin(blockSize, length - pos));
+        }
+        const double timeStereo = secondsSince(start) / 2;
+
+        // impulse response of the band sum, evaluated on a log grid
+        Crossover probe;
+        probe.setParameters(&split);
+        probe.setfs((float)fs);
+
+        const int irLength = 1 << 15;
+        std::vector<float> impulse(irLength, 0.0f), sum(irLength, 0.0f);
+        impulse[0] = 1;
+        for (int pos = 0; pos < irLength; pos += blockSize)
+        {
+            probe.process(impulse.data() + pos, bands, blockSize);
+            for (int i = 0; i < blockSize; i++)
+                sum[pos + i] = bands[LOW][i] + bands[MID][i] + bands[HHI][i];
+        }
+
+        double maxErr = 0;
+        for (double f = 40; f < 20000; f *= 1.1)
+        {
+            std::complex<double> h = 0;
+            for (int i = 0; i < irLength; i++)
+                h += (double)sum[i] * std::polar(1.0, -juce::MathConstants<double>::twoPi * f / fs * i);
+            maxErr = juce::jmax(maxErr, std::abs(juce::Decibels::gainToDecibels(std::abs(h), -200.0)));
+        }
+
+        std::printf("%-14s %8d %10.2f %8.2f %14.2f %12.2f %14.4f\n", names[order], crossover.getStages(),
+            time * 1e9 / length, refTime / time, timeDelayed * 1e9 / length, timeStereo * 1e9 / length, maxErr);
+    }
+    return 0;
+}
@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+
+    EditorBench.cpp
+    Created: 19 Oct 2026 11:48:30pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <map>
+#include <typeinfo>
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "Benchmarks.h"
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+
+// Off-screen editor benchmark: the editor of a processor fed with the
+// synthetic program is rendered into a software image at several sizes and
+// display scales, no window and no peer. Per frame it reports the full
+// repaint, the layout of every component (its resized() alone) and the
+// paint of every component (its own paint() and paintOverChildren(), no
+// children), summed per class.
+// Not measured: the response renders (shared workers, off the message
+// thread) and the display refresh callbacks, which need a peer.
+
+static const struct { int width, height; } sizes[] =
+{
+    {  500,  425 },     // default
+    {  750,  638 },
+    { 1000,  850 },
+};
+static const float scales[] = { 1.0f, 2.0f };
+static const int frames = 100;
+static const int blockSize = 512;
+
+// readable class name of a component (Itanium or MSVC type names)
+static juce::String className(const juce::Component& c)
+{
+    juce::String raw = typeid(c).name();
+    if (raw.startsWith("class "))  return raw.substring(6);
+    if (raw.startsWith("struct ")) return raw.substring(7);
+
+    // "15metersComponent", "N4juce6SliderE"
+    juce::String name;
+    int i = raw.startsWithChar('N') ? 1 : 0;
+    while (i < raw.length() && juce::CharacterFunctions::isDigit(raw[i]))
+    {
+        int length = raw.substring(i).getIntValue();
+        i += juce::String(length).length();
+        name << (name.isEmpty() ? "" : "::") << raw.substring(i, i + length);
+        i += length;
+    }
+    return name.isEmpty() ? raw : name;
+}
+static void collect(juce::Component& c, std::vector<juce::Component*>& all)
+{
+    all.push_back(&c);
+    for (auto* child : c.getChildren())
+        collect(*child, all);
+}
+
+// component to editor coordinates as the parents' paint passes compose
+// them: position, then the component's own transform, up to the editor
+static juce::AffineTransform toEditor(const juce::Component& editor, const juce::Component& c)
+{
+    juce::AffineTransform t;
+    for (auto* p = &c; p != nullptr && p != &editor; p = p->getParentComponent())
+        t = t.translated((float)p->getX(), (float)p->getY()).followedBy(p->getTransform());
+    return t;
+}
+
+struct Timing {
+    int instances = 0;
+    double layout = 0;  // [s] over all frames
+    double paint = 0;
+};
+
+int runEditorPaintBench()
+{
+    MBComp01AudioProcessor processor;
+    processor.prepareToPlay(48000, blockSize);
+    std::unique_ptr<juce::AudioProcessorEditor> editor(processor.createEditorIfNeeded());
+    // levels as with an editor on screen
+    processor.subscribeMeters(true);
+
+    const auto program = makeProgram(48000, 10);
+    juce::AudioBuffer<float> block(2, blockSize);
+    juce::MidiBuffer midi;
+    size_t pos = 0;
+    auto feed = [&]
+        {
+            for (int ch = 0; ch < block.getNumChannels(); ch++)
+                block.copyFrom(ch, 0, program.data() + pos, blockSize);
+            processor.processBlock(block, midi);
+            pos = (pos + blockSize) % (program.size() - blockSize);
+        };
+
+    for (const auto& size : sizes)
+        for (float scale : scales)
+        {
+            editor->setSize(size.width, size.height);
+            std::vector<juce::Component*> all;
+            collect(*editor, all);
+
+            juce::Image image(juce::Image::ARGB, juce::roundToInt(size.width * scale),
+                              juce::roundToInt(size.height * scale), true, juce::SoftwareImageType());
+            std::map<juce::String, Timing> timings;
+            double frame = 0, layout = 0;
+
+            for (int f = 0; f < frames; f++)
+            {
+                feed();
+
+                // the whole editor, as its peer would repaint it
+                {
+                    juce::Graphics g(image);
+                    g.addTransform(juce::AffineTransform::scale(scale));
+                    auto start = juce::Time::getHighResolutionTicks();
+                    editor->paintEntireComponent(g, false);
+                    frame += secondsSince(start);
+                }
+
+                for (auto* c : all)
+                {
+                    Timing& t = timings[className(*c)];
+
+                    auto start = juce::Time::getHighResolutionTicks();
+                    c->resized();
+                    double elapsed = secondsSince(start);
+                    t.layout += elapsed;
+                    layout += elapsed;
+
+                    juce::Graphics g(image);
+                    g.addTransform(toEditor(*editor, *c).followedBy(juce::AffineTransform::scale(scale)));
+                    g.reduceClipRegion(c->getLocalBounds());
+                    start = juce::Time::getHighResolutionTicks();
+                    c->paint(g);
+                    c->paintOverChildren(g);
+                    t.paint += secondsSince(start);
+                }
+            }
+            for (auto* c : all)
+                timings[className(*c)].instances++;
+
+            std::printf("%dx%d @%gx: frame %.1f us, layout %.1f us (%d components)\n",
+                size.width, size.height, scale, 1e6 * frame / frames, 1e6 * layout / frames, (int)all.size());
+
+            std::vector<std::pair<juce::String, Timing>> rows(timings.begin(), timings.end());
+            std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) { return a.second.paint > b.second.paint; });
+            std::printf("  %-34s %5s %12s %12s\n", "class", "count", "paint [us]", "layout [us]");
+            for (const auto& row : rows)
+                std::printf("  %-34s %5d %12.2f %12.2f\n", row.first.toRawUTF8(), row.second.instances,
+                    1e6 * row.second.paint / frames, 1e6 * row.second.layout / frames);
+        }
+
+    editor.reset();
+    return 0;
+}
+
+//==============================================================================
+static const struct { const char* name; int (*run)(); const char* description; } benchmarks[] =
+{
+    { "paint",   runEditorPaintBench, "editor layout and paint per component, sizes and scales" },
+    { "startup", runStartupBench,     "time to first audio and to a painted editor per instance" },
+    { "events",  runEventsBench,      "automation overflowing the parameter queue, checks the final values" },
+};
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::printf("usage: MBCompEditorBench <name>|all\n\n");
+        for (const auto& b : benchmarks)
+            std::printf("  %-14s %s\n", b.name, b.description);
+        return 1;
+    }
+
+    // message manager for the components, no windows
+    juce::ScopedJuceInitialiser_GUI gui;
+
+    int result = 0;
+    bool found = false;
+    for (const auto& b : benchmarks)
+    {
+        if (std::strcmp(argv[1], "all") != 0 && std::strcmp(argv[1], b.name) != 0)
+            continue;
+
+        std::printf("== %s ==\n", b.name);
+        result |= b.run();
+        found = true;
+    }
+
+    if (!found)
+    {
+        std::printf("unknown benchmark: %s\n", argv[1]);
+        return 1;
+    }
+    return result;
+}
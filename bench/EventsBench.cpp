@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    EventsBench.cpp
+    Created: 20 Oct 2026 10:12:37am
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#include <cstdio>
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "Benchmarks.h"
+#include "PluginProcessor.h"
+
+// Host automation overflowing the parameter queue between two blocks. The
+// processor reads the parameters again and drops the stale events still
+// queued, so the render after must equal one that started on the final
+// values. Also reports the cost of one automated parameter change.
+
+static const int blockSize = 512;
+
+static void render(MBComp01AudioProcessor& processor, const std::vector<float>& program, std::vector<float>& out)
+{
+    juce::AudioBuffer<float> block(2, blockSize);
+    juce::MidiBuffer midi;
+    out.clear();
+    for (size_t pos = 0; pos + blockSize <= program.size(); pos += blockSize)
+    {
+        for (int ch = 0; ch < 2; ch++)
+            block.copyFrom(ch, 0, program.data() + pos, blockSize);
+        processor.processBlock(block, midi);
+        out.insert(out.end(), block.getReadPointer(0), block.getReadPointer(0) + blockSize);
+    }
+}
+
+static void set(juce::RangedAudioParameter* param, float plainValue)
+{
+    param->setValueNotifyingHost(param->convertTo0to1(plainValue));
+}
+
+int runEventsBench()
+{
+    const double fs = 48000;
+    const auto program = makeProgram(fs, 1);
+    const float finalCT = -36.0f, finalCR = 6.0f;
+    const int changes = 4 * PARAM_QUEUE_SIZE;
+
+    // reference: the final values before the first block
+    std::vector<float> expected, flooded;
+    {
+        MBComp01AudioProcessor processor;
+        set(processor.getCT(LOW), finalCT);
+        set(processor.getCR(LOW), finalCR);
+        processor.prepareToPlay(fs, blockSize);
+        render(processor, program, expected);
+    }
+
+    // the same values as the last of a burst the queue cannot hold
+    MBComp01AudioProcessor processor;
+    processor.prepareToPlay(fs, blockSize);
+    auto start = juce::Time::getHighResolutionTicks();
+    for (int i = 0; i < changes; i++)
+    {
+        set(processor.getCT(LOW), -50.0f + (float)(i % 40));
+        set(processor.getCR(LOW), 1.0f + (float)(i % 10));
+    }
+    const double time = secondsSince(start);
+    set(processor.getCT(LOW), finalCT);
+    set(processor.getCR(LOW), finalCR);
+    render(processor, program, flooded);
+
+    double maxError = 0;
+    for (size_t i = 0; i < expected.size(); i++)
+        maxError = juce::jmax(maxError, (double)std::abs(flooded[i] - expected[i]));
+
+    std::printf("%d changes into a queue of %d: %.1f ns per change\n", 2 * changes, PARAM_QUEUE_SIZE,
+        time * 1e9 / (2 * changes));
+    std::printf("final values after the overflow: max error %.2e %s\n", maxError, maxError == 0 ? "ok" : "FAILED");
+    return maxError == 0 ? 0 : 1;
+}
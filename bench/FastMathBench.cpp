@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    FastMathBench.cpp
+    Created: 19 Oct 2026 7:52:30pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#include <cstdio>
+#include <cmath>
+#include <juce_core/juce_core.h>
+#include "Benchmarks.h"
+#include "FastMath.h"
+
+// Error is absolute below 1 and relative above (|exact| > 1), or relative
+// over the whole range where FastMath.h gives a relative bound (`relative`).
+// `vec` is the float4 version, it has to match the scalar one.
+template <class Fast, class Vec, class Slow, class Exact>
+static bool runCase(const char* name, double lo, double hi, bool logSweep, double bound, bool relative,
+    Fast fast, Vec vec, Slow slow, Exact exact)
+{
+    const int points = 1 << 20;
+    std::vector<float> input(points), output(points);
+
+    for (int i = 0; i < points; i++)
+    {
+        double u = (double)i / (points - 1);
+        input[i] = (float)(logSweep ? lo * std::pow(hi / lo, u) : lo + (hi - lo) * u);
+    }
+
+    double maxErr = 0;
+    for (int i = 0; i < points; i++)
+    {
+        double y = exact((double)input[i]);
+        double err = std::abs((double)fast(input[i]) - y) / (relative ? std::abs(y) : juce::jmax(1.0, std::abs(y)));
+        maxErr = juce::jmax(maxErr, err);
+    }
+
+    bool same = true;
+    for (int i = 0; i < points; i += 4)
+    {
+        float lanes[4];
+        vec(float4::load(&input[i])).store(lanes);
+        for (int l = 0; l < 4; l++)
+            same &= std::abs(lanes[l] - fast(input[i + l])) <= 1e-6f * juce::jmax(1.0f, std::abs(lanes[l]));
+    }
+
+    // timed on a shuffled copy so the branches of libm see no pattern,
+    // the loops are inlined as they are in the processors
+    juce::Random random(2);
+    for (int i = points - 1; i > 0; i--)
+        std::swap(input[i], input[random.nextInt(i + 1)]);
+
+    auto time = [&](auto f)
+        {
+            auto start = juce::Time::getHighResolutionTicks();
+            for (int rep = 0; rep < 8; rep++)
+                for (int i = 0; i < points; i++)
+                    output[i] = f(input[i]);
+            return secondsSince(start) * 1e9 / (8.0 * points);
+        };
+    const double fastTime = time(fast);
+    const double slowTime = time(slow);
+
+    auto start = juce::Time::getHighResolutionTicks();
+    for (int rep = 0; rep < 8; rep++)
+        for (int i = 0; i < points; i += 4)
+            vec(float4::load(&input[i])).store(&output[i]);
+    const double vecTime = secondsSince(start) * 1e9 / (8.0 * points);
+
+    const bool ok = maxErr <= bound && same;
+    std::printf("%-12s %10.3g %8.1g %9.2f %9.2f %9.2f %8.2f %s\n", name, maxErr, bound,
+        slowTime, fastTime, vecTime, slowTime / vecTime, ok ? "" : "FAIL");
+    return ok;
+}
+
+// Accuracy of the fastmath functions against libm (in double) over the
+// documented ranges, and their speed against the float libm calls. Fails
+// if an error exceeds the bound documented in FastMath.h.
+int runFastMathBench()
+{
+    bool ok = true;
+
+    std::printf("%-12s %10s %8s %9s %9s %9s %8s\n", "function", "max err", "bound",
+        "libm ns", "fast ns", "float4 ns", "speedup");
+    ok &= runCase("log2", 1e-30, 1e30, true, 3e-7, false,
+        [](float x) { return fastmath::fast_log2(x); },
+        [](float4 x) { return fastmath::fast_log2(x); },
+        [](float x) { return std::log2(x); },
+        [](double x) { return std::log2(x); });
+    ok &= runCase("exp2", -126, 126, false, 3e-7, true,
+        [](float x) { return fastmath::fast_exp2(x); },
+        [](float4 x) { return fastmath::fast_exp2(x); },
+        [](float x) { return std::exp2(x); },
+        [](double x) { return std::exp2(x); });
+    ok &= runCase("db_to_gain", -200, 200, false, 3e-6, true,
+        [](float x) { return fastmath::fast_db_to_gain(x); },
+        [](float4 x) { return fastmath::fast_db_to_gain(x); },
+        [](float x) { return std::pow(10.0f, x / 20); },
+        [](double x) { return std::pow(10.0, x / 20); });
+    ok &= runCase("gain_to_db", 1e-10, 1e10, true, 5e-7, false,
+        [](float x) { return fastmath::fast_gain_to_db(x); },
+        [](float4 x) { return fastmath::fast_gain_to_db(x); },
+        [](float x) { return 20 * std::log10(x); },
+        [](double x) { return 20 * std::log10(x); });
+
+    return ok ? 0 : 1;
+}
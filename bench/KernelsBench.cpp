@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    KernelsBench.cpp
+    Created: 19 Oct 2026 9:58:14pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#include <cstdio>
+#include <juce_core/juce_core.h>
+#include "Benchmarks.h"
+#include "Kernels.h"
+
+// Every kernel table the CPU can run against the baseline one: time per
+// sample of a band split + gain + mix pass, and the largest difference of
+// the results (FMA and summation order only).
+int runKernelsBench()
+{
+    std::vector<const KernelTable*> tables = { &kernels::baseline };
+#if MBCOMP_X86_KERNELS
+    if (juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3())
+        tables.push_back(&kernels::avx2);
+    if (juce::SystemStats::hasAVX512F() && juce::SystemStats::hasAVX512VL())
+        tables.push_back(&kernels::avx512);
+#endif
+    std::printf("selected: %s\n", kernels::get().name);
+
+    const int blockSize = 512;
+    const auto x = makeProgram(48000, 30);
+    const int length = (int)x.size() / blockSize * blockSize;
+
+    // LR4 at 200 Hz / 2 kHz, 48 kHz
+    float coef[CX_MAX_STAGES][5][4] = {};
+    const float lp0[5] = { 1.6e-4f, 3.3e-4f, 1.6e-4f, -1.963f, 0.9636f };
+    const float hp0[5] = { 0.9816f, -1.963f, 0.9816f, -1.963f, 0.9636f };
+    for (int s = 0; s < 4; s++)
+        for (int c = 0; c < 5; c++)
+        {
+            coef[s][c][0] = s < 2 ? lp0[c] : (c == 0 ? 1.0f : 0.0f);
+            coef[s][c][1] = coef[s][c][2] = hp0[c];
+            coef[s][c][3] = c == 0 ? 1.0f : 0.0f;
+        }
+
+    std::vector<float> storage(6 * blockSize), reference, result;
+    float* bands[3] = { storage.data(), storage.data() + blockSize, storage.data() + 2 * blockSize };
+    float* gain = storage.data() + 3 * blockSize;
+    float* out = storage.data() + 4 * blockSize;
+    float* side = storage.data() + 5 * blockSize;
+    for (int i = 0; i < blockSize; i++)
+        gain[i] = 0.5f + 0.5f * i / blockSize;
+
+    auto render = [&](const KernelTable& k, std::vector<float>& y)
+        {
+            float state[CX_MAX_STAGES][2][8] = {};
+            y.resize(length);
+            auto start = juce::Time::getHighResolutionTicks();
+            for (int pos = 0; pos < length; pos += blockSize)
+            {
+                k.crossover(x.data() + pos, bands, blockSize, coef, state, 4);
+                for (int i = 0; i < blockSize; i++)
+                    out[i] = side[i] = 0;
+                for (int band = 0; band < 3; band++)
+                {
+                    k.scale(bands[band], 1.1f, blockSize);
+                    k.mixGain(side, bands[band], gain, 0.9f, blockSize);
+                    k.applyGain(bands[band], gain, 1.0f, blockSize);
+                    k.mix(out, bands[band], 0.9f, blockSize);
+                }
+                out[0] += 1e-9f * k.sumSquares(side, blockSize);
+                std::copy(out, out + blockSize, y.begin() + pos);
+            }
+            return secondsSince(start);
+        };
+
+    const double refTime = render(kernels::baseline, reference);
+    std::printf("%-10s %10s %8s %12s\n", "kernels", "ns/sample", "speedup", "max diff");
+    for (auto* table : tables)
+    {
+        const double time = render(*table, result);
+        double maxDiff = 0;
+        for (int i = 0; i < length; i++)
+            maxDiff = juce::jmax(maxDiff, (double)std::abs(result[i] - reference[i]));
+        std::printf("%-10s %10.2f %8.2f %12.3g\n", table->name, time * 1e9 / length, refTime / time, maxDiff);
+    }
+    return 0;
+}
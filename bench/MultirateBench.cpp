@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    MultirateBench.cpp
+    Created: 19 Oct 2026 4:20:51pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#include <cstdio>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "Benchmarks.h"
+#include "Compressor.h"
+#include "defines.h"
+
+// Low band detector at 192 kHz, full rate against decimated detection. The
+// decimator's group delay comes out of the lookahead; factors whose delay
+// does not fit are skipped, as in the processor.
+int runMultirateBench()
+{
+    const double fs = 192000;
+    const float edge = 200;
+    const int blockSize = 512;
+    auto x = makeProgram(fs, 20);
+    const int length = (int)x.size();
+
+    // first order lowpass, same slope as the low band of the crossover
+    const float a = 1 - (float)std::exp(-juce::MathConstants<double>::twoPi * edge / fs);
+    float state = 0;
+    for (auto& sample : x)
+        sample = (state += a * (sample - state));
+
+    CompressorParameters params;
+    params.at = 10.0f;
+    params.rt = 150.0f;
+    params.la = 5.0f;
+    params.CT = -30.0f;
+    params.CR = 4.0f;
+
+    auto render = [&](int factor, std::vector<float>& gain)
+        {
+            Compressor comp;
+            comp.setParameters(&params);
+            comp.setfs(fs);
+            comp.setDecimation(factor);
+
+            gain.resize(x.size());
+            auto start = juce::Time::getHighResolutionTicks();
+            for (int pos = 0; pos < length; pos += blockSize)
+            {
+                comp.setInputBuffer(x.data() + pos);
+                comp.setGainBuffer(gain.data() + pos);
+                comp.process(juce::jmin(blockSize, length - pos));
+            }
+            return secondsSince(start);
+        };
+
+    std::vector<float> reference, gain;
+    const double refTime = render(1, reference);
+
+    std::printf("%-8s %10s %8s %10s %14s %14s\n", "factor", "ns/sample", "speedup", "delay [ms]", "max dev [dB]", "mean dev [dB]");
+    std::printf("%-8d %10.2f %8.2f %10.3f %14s %14s\n", 1, refTime * 1e9 / length, 1.0, 0.0, "-", "-");
+
+    const int lookahead = (int)(params.la * fs / 1000);
+    for (int factor = 2; factor <= MAX_DECIMATION; factor *= 2)
+    {
+        if (Decimator::delayFor(factor) > lookahead)
+            break;
+
+        const double time = render(factor, gain);
+
+        double maxDev = 0, meanDev = 0;
+        for (int i = 0; i < length; i++)
+        {
+            double dev = std::abs(juce::Decibels::gainToDecibels((double)gain[i], -200.0)
+                                - juce::Decibels::gainToDecibels((double)reference[i], -200.0));
+            maxDev = juce::jmax(maxDev, dev);
+            meanDev += dev;
+        }
+
+        std::printf("%-8d %10.2f %8.2f %10.3f %14.3f %14.3f\n", factor, time * 1e9 / length,
+            refTime / time, Decimator::delayFor(factor) * 1000 / fs, maxDev, meanDev / length);
+    }
+    return 0;
+}
@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    StartupBench.cpp
+    Created: 19 Oct 2026 11:59:52pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#include <cstdio>
+#include <algorithm>
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "Benchmarks.h"
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+
+// Session load of many instances, one after the other, as a host does it:
+//   first audio:    construct, restore the state, prepareToPlay, one block
+//   editor visible: create the editor, lay it out and paint it once
+// Every instance stays alive until the end, like in a session.
+
+static const int instances = 200;
+static const int blockSize = 512;
+
+static void report(const char* what, std::vector<double>& t)
+{
+    std::sort(t.begin(), t.end());
+    double sum = 0;
+    for (double x : t) sum += x;
+    std::printf("%-16s mean %8.1f us  median %8.1f us  max %8.1f us  total %7.1f ms\n", what,
+        1e6 * sum / t.size(), 1e6 * t[t.size() / 2], 1e6 * t.back(), 1e3 * sum);
+}
+
+int runStartupBench()
+{
+    // the state every instance restores
+    juce::MemoryBlock state;
+    {
+        MBComp01AudioProcessor reference;
+        reference.getStateInformation(state);
+    }
+
+    const auto program = makeProgram(48000, 1);
+    juce::AudioBuffer<float> block(2, blockSize);
+    juce::MidiBuffer midi;
+    juce::Image image(juce::Image::ARGB, EDITOR_W, EDITOR_H, true, juce::SoftwareImageType());
+
+    std::vector<std::unique_ptr<MBComp01AudioProcessor>> processors;
+    std::vector<std::unique_ptr<juce::AudioProcessorEditor>> editors;
+    std::vector<double> audio, editor;
+
+    for (int i = 0; i < instances; i++)
+    {
+        auto start = juce::Time::getHighResolutionTicks();
+        auto processor = std::make_unique<MBComp01AudioProcessor>();
+        processor->setStateInformation(state.getData(), (int)state.getSize());
+        processor->prepareToPlay(48000, blockSize);
+        for (int ch = 0; ch < block.getNumChannels(); ch++)
+            block.copyFrom(ch, 0, program.data(), blockSize);
+        processor->processBlock(block, midi);
+        audio.push_back(secondsSince(start));
+
+        start = juce::Time::getHighResolutionTicks();
+        std::unique_ptr<juce::AudioProcessorEditor> e(processor->createEditorIfNeeded());
+        {
+            juce::Graphics g(image);
+            e->paintEntireComponent(g, false);
+        }
+        editor.push_back(secondsSince(start));
+
+        processors.push_back(std::move(processor));
+        editors.push_back(std::move(e));
+    }
+
+    std::printf("%d instances\n", instances);
+    report("first audio", audio);
+    report("editor visible", editor);
+
+    // editors go before their processors
+    editors.clear();
+    return 0;
+}
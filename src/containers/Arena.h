@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+    Arena.h
+    Created: 19 Oct 2026 10:02:48pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#define ARENA_ALIGN         64      // [bytes] cache line
+#define ARENA_MAX_OBJECTS   32      // create() calls with a destructor to run
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+// One cache line aligned block holding the per-instance state of the
+// processors. Every allocation starts on a cache line, so objects of
+// different channels never share one. reserve() keeps the block when the
+// new layout fits, clear() destroys the objects but keeps the memory, so a
+// re-prepare with the same (or a smaller) configuration does not touch the
+// heap.
+class Arena {
+public:
+    //==================================================================
+    Arena() : base(nullptr), capacity(0), used(0), numObjects(0)
+    {
+    }
+    ~Arena()
+    {
+        release();
+    }
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    //==================================================================
+    // bytes taken by `count` T-s, padding included
+    template <class T>
+    static size_t bytes(size_t count)
+    {
+        return align(count * sizeof(T));
+    }
+    // Makes room for `size` bytes. Destroys what is in the arena, the
+    // block is only reallocated when it is too small.
+    void reserve(size_t size)
+    {
+        clear();
+        if (size <= capacity) return;
+
+        release();
+        base = static_cast<char*>(::operator new(size, std::align_val_t(ARENA_ALIGN)));
+        capacity = size;
+    }
+    // destroys the objects in reverse order, keeps the memory
+    void clear()
+    {
+        while (numObjects > 0)
+        {
+            Object& o = objects[--numObjects];
+            o.destroy(o.first, o.count);
+        }
+        used = 0;
+    }
+    void release()
+    {
+        clear();
+        if (base != nullptr)
+            ::operator delete(base, std::align_val_t(ARENA_ALIGN));
+        base = nullptr;
+        capacity = 0;
+    }
+    //==================================================================
+    // uninitialized storage for `count` T-s
+    template <class T>
+    T* allocate(size_t count)
+    {
+        static_assert(alignof(T) <= ARENA_ALIGN, "over-aligned type");
+        const size_t size = bytes<T>(count);
+        if (used + size > capacity) throw("arena overflow");
+
+        T* p = reinterpret_cast<T*>(base + used);
+        used += size;
+        return p;
+    }
+    // `count` default constructed T-s, destroyed by clear()
+    template <class T>
+    T* create(size_t count)
+    {
+        T* p = allocate<T>(count);
+        for (size_t i = 0; i < count; i++)
+            new (p + i) T();
+
+        if (!std::is_trivially_destructible<T>::value)
+        {
+            if (numObjects == ARENA_MAX_OBJECTS) throw("too many arena objects");
+            objects[numObjects++] = { p, count, &destroyAll<T> };
+        }
+        return p;
+    }
+    //==================================================================
+    size_t getCapacity() const
+    {
+        return capacity;
+    }
+    size_t getUsed() const
+    {
+        return used;
+    }
+
+private:
+    //==================================================================
+    static size_t align(size_t size)
+    {
+        return (size + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN;
+    }
+    template <class T>
+    static void destroyAll(void* first, size_t count)
+    {
+        T* p = static_cast<T*>(first);
+        for (size_t i = count; i > 0; i--)
+            p[i - 1].~T();
+    }
+
+    struct Object {
+        void* first;
+        size_t count;
+        void (*destroy)(void*, size_t);
+    };
+    //==================================================================
+    char* base;
+    size_t capacity;
+    size_t used;
+
+    Object objects[ARENA_MAX_OBJECTS];
+    int numObjects;
+};
@@ -10,12 +10,14 @@
 
 #pragma once
 
+#include <algorithm>
+
 template <class T>
 class CircularBuffer {
 public:
     //==================================================================
     CircularBuffer(int bufferSize = 0)
-        : size(bufferSize)
+        : size(bufferSize), capacity(bufferSize), owned(true)
     {
         if (size < 0) throw("negative size");
 
@@ -26,13 +28,27 @@ public:
             base[i] = 0;
     }
     ~CircularBuffer() {
-        delete[] base;
+        if (owned) delete[] base;
     }
     //==================================================================
     int getSize() const
     {
         return size;
     }
+    // Moves the buffer to `storage` (not owned), it becomes storageSize
+    // long and cleared. resize() stays in place up to storageSize.
+    void setStorage(T* storage, int storageSize)
+    {
+        if (storageSize < 0) throw("negative size");
+
+        if (owned) delete[] base;
+        base = storage;
+        size = capacity = storageSize;
+        owned = false;
+        cur = 0;
+        for (int i = 0; i < size; i++)
+            base[i] = 0;
+    }
     T push(T _new) {
 
         if (size == 0) return _new;
@@ -42,6 +58,37 @@ public:
         if (cur >= size) cur -= size;
         return last;
     }
+    // push() of n samples, `out` may be `in`: copies in runs up to the end
+    // of the ring instead of a wrap check per sample
+    void push(const T* in, T* out, int n)
+    {
+        if (size == 0)
+        {
+            if (out != in) std::copy(in, in + n, out);
+            return;
+        }
+        while (n > 0)
+        {
+            const int run = std::min(n, size - cur);
+            if (out == in)
+                std::swap_ranges(base + cur, base + cur + run, out);
+            else
+            {
+                std::copy(base + cur, base + cur + run, out);
+                std::copy(in, in + run, base + cur);
+            }
+            cur += run;
+            if (cur >= size) cur -= size;
+            in += run;
+            out += run;
+            n -= run;
+        }
+    }
+    void clear()
+    {
+        std::fill(base, base + size, T(0));
+        cur = 0;
+    }
     T& getCur()
     {
         return base[cur];
@@ -60,6 +107,20 @@ public:
         if (size == _size) return;
 
         flatten();
+        if (_size <= capacity)
+        {
+            // in place, the most recent data stays at the end
+            if (_size > size)
+            {
+                std::copy_backward(base, base + size, base + _size);
+                std::fill(base, base + _size - size, T(0));
+            }
+            else
+                std::copy(base + size - _size, base + size, base);
+            size = _size;
+            return;
+        }
+
         T* new_buf = new T[_size];
 
         for (int i = 1; i <= _size; i++) 
@@ -70,28 +131,23 @@ public:
                 new_buf[_size - i] = 0;
         }
 
-        delete[] base;
+        if (owned) delete[] base;
         base = new_buf;
+        owned = true;
 
-        size = _size;
+        size = capacity = _size;
     }
+    // oldest element to the front, in place
     void flatten()
     {
-        T* flat = new T[size];
-        int i = 0;
-
-        for (i; i < size - cur; i++)        // whatever was left in the end of the buffer
-            flat[i] = base[cur + i];
-        for (i; i < size; i++)                  // most recent data
-            flat[i] = base[i - size + cur];
-
+        std::rotate(base, base + cur, base + size);
         cur = 0;
-        delete[] base;
-        base = flat;
     }
     //==================================================================
 private:
     int size;
+    int capacity;   // elements at base
+    bool owned;     // base is ours to delete
     T*  base;
     // always pointing at the oldest element, about to be overwritten
     int cur;
@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+    EventQueue.h
+    Created: 19 Oct 2026 10:47:15pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+
+// Lock-free multi producer ring of events (bounded, after Vyukov). Every slot
+// carries a sequence number telling whose turn it is; producers claim a slot
+// with one compare-exchange on the write position and publish it through the
+// sequence, so a producer never waits for another one, it only retries when
+// someone else got the slot first. The storage is allocated once, push()
+// and pop() never block and never allocate; push() fails when the ring is
+// full. pop() is safe from several consumers, front() only when there is
+// one.
+template <class T>
+class EventQueue {
+public:
+    //==================================================================
+    // capacity is rounded up to a power of two
+    EventQueue(int capacity = 1024) : size(1), readPos(0), writePos(0)
+    {
+        if (capacity < 1) throw("empty queue");
+
+        while (size < capacity)
+            size *= 2;
+        slots = new Slot[size];
+        for (int i = 0; i < size; i++)
+            slots[i].turn.store((unsigned)i, std::memory_order_relaxed);
+    }
+    ~EventQueue()
+    {
+        delete[] slots;
+    }
+    EventQueue(const EventQueue&) = delete;
+    EventQueue& operator=(const EventQueue&) = delete;
+    //==================================================================
+    // producer side, any number of threads
+    bool push(const T& event)
+    {
+        unsigned w = writePos.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;)
+        {
+            slot = slots + (w & (size - 1));
+            const int ahead = (int)(slot->turn.load(std::memory_order_acquire) - w);
+            if (ahead == 0)
+            {
+                // free for position w, claim it (w is reloaded on failure)
+                if (writePos.compare_exchange_weak(w, w + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (ahead < 0)
+                return false;   // the consumer has not freed it yet: full
+            else
+                w = writePos.load(std::memory_order_relaxed);
+        }
+
+        slot->event = event;
+        slot->turn.store(w + 1, std::memory_order_release);
+        return true;
+    }
+    //==================================================================
+    // consumer side: the oldest event or nullptr, valid until pop(); a slot
+    // claimed but not yet written reads as empty
+    const T* front() const
+    {
+        const unsigned r = readPos.load(std::memory_order_relaxed);
+        const Slot* slot = slots + (r & (size - 1));
+        if (slot->turn.load(std::memory_order_acquire) != r + 1)
+            return nullptr;
+        return &slot->event;
+    }
+    bool pop(T& event)
+    {
+        unsigned r = readPos.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;)
+        {
+            slot = slots + (r & (size - 1));
+            const int ahead = (int)(slot->turn.load(std::memory_order_acquire) - (r + 1));
+            if (ahead == 0)
+            {
+                if (readPos.compare_exchange_weak(r, r + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (ahead < 0)
+                return false;   // empty
+            else
+                r = readPos.load(std::memory_order_relaxed);
+        }
+
+        event = slot->event;
+        // free for the producer one lap later
+        slot->turn.store(r + (unsigned)size, std::memory_order_release);
+        return true;
+    }
+    int getCapacity() const
+    {
+        return size;
+    }
+    // positions count the events claimed by the producers and popped by the
+    // consumers so far (wrapping); with a single consumer getReadCount() is
+    // the position of front()
+    unsigned getWriteCount() const
+    {
+        return writePos.load(std::memory_order_acquire);
+    }
+    unsigned getReadCount() const
+    {
+        return readPos.load(std::memory_order_relaxed);
+    }
+
+private:
+    //==================================================================
+    struct Slot {
+        std::atomic<unsigned> turn;     // position the slot is ready for: w to write, r + 1 to read
+        T event;
+    };
+
+    int size;
+    Slot* slots;
+    // claimed by each side, kept on separate cache lines
+    alignas(64) std::atomic<unsigned> readPos;
+    alignas(64) std::atomic<unsigned> writePos;
+};
@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+    SlidingMax.h
+    Created: 19 Oct 2026 1:14:40pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Running maximum of the last `window` pushed values.
+// Monotonic deque: every value is pushed and popped at most once, so the
+// cost is O(1) amortized per sample regardless of the window length.
+// Storage is allocated by resize() only (or given by setStorage()), push()
+// never allocates.
+template <class T>
+class SlidingMax {
+public:
+    //==================================================================
+    SlidingMax(int capacity = 0)
+        : size(0), window(0), values(nullptr), stamps(nullptr), owned(true),
+        head(0), count(0), now(0)
+    {
+        resize(capacity);
+    }
+    ~SlidingMax() {
+        free();
+    }
+    //==================================================================
+    int getCapacity() const
+    {
+        return size;
+    }
+    int getWindow() const
+    {
+        return window;
+    }
+    // number of samples the maximum is taken over, 1 <= w <= capacity
+    void setWindow(int w)
+    {
+        if (w > size) w = size;
+        if (w < 1) w = 1;
+        window = w;
+    }
+    // reallocates the storage, forgets the history
+    void resize(int capacity)
+    {
+        if (capacity < 0) throw("negative size");
+
+        free();
+
+        size = capacity > 0 ? capacity : 1;
+        values = new T[size];
+        stamps = new unsigned int[size];
+        owned = true;
+        window = size;
+        clear();
+    }
+    // same as resize() on caller owned arrays of `capacity` elements
+    void setStorage(T* valueStorage, unsigned int* stampStorage, int capacity)
+    {
+        if (capacity < 1) throw("empty storage");
+
+        free();
+
+        size = capacity;
+        values = valueStorage;
+        stamps = stampStorage;
+        owned = false;
+        window = size;
+        clear();
+    }
+    void clear()
+    {
+        head = 0;
+        count = 0;
+        now = 0;
+    }
+    //==================================================================
+    T push(T _new)
+    {
+        // dropping what leaves the window first keeps count < size below,
+        // unsigned difference stays correct across wrap-around
+        while (count > 0 && now - stamps[head] >= (unsigned int)window)
+        {
+            if (++head >= size) head = 0;
+            count--;
+        }
+        // values smaller than the new one can never be the maximum again
+        while (count > 0 && values[back()] <= _new)
+            count--;
+
+        int slot = head + count;
+        if (slot >= size) slot -= size;
+        values[slot] = _new;
+        stamps[slot] = now;
+        count++;
+
+        now++;
+        return values[head];
+    }
+    T getMax() const
+    {
+        return values[head];
+    }
+    //==================================================================
+private:
+    void free()
+    {
+        if (owned)
+        {
+            delete[] values;
+            delete[] stamps;
+        }
+        values = nullptr;
+        stamps = nullptr;
+    }
+    int back() const
+    {
+        int slot = head + count - 1;
+        return slot >= size ? slot - size : slot;
+    }
+
+    int size;
+    int window;
+    T* values;
+    unsigned int* stamps;
+    bool owned;     // values and stamps are ours to delete
+
+    int head;   // oldest candidate (current maximum)
+    int count;  // candidates in the deque
+    unsigned int now;
+};
@@ -12,8 +12,6 @@
 
 #define _USE_MATH_DEFINES
 
-#include <juce_core/juce_core.h>
-#include <juce_audio_basics/juce_audio_basics.h>
 #include <cmath>
 #include "math.h"
 
@@ -90,7 +88,8 @@ public:
     {
         NegOut = bufferPointer;
     }
-    void setfc(juce::AudioParameterFloat* param_ptr)
+    // plain value [Hz], owned by the caller
+    void setfc(const float* param_ptr)
     {
         fc = param_ptr;
     }
@@ -101,7 +100,7 @@ public:
 
 private:
     //==================================================================
-    juce::AudioParameterFloat* fc;
+    const float* fc;
     
     float* InBuf;
     float* Out;
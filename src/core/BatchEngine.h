@@ -0,0 +1,333 @@
+/*
+  ==============================================================================
+
+    BatchEngine.h
+    Created: 20 Oct 2026 12:14:36am
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#define _USE_MATH_DEFINES
+
+#define BATCH_CHUNK      64     // samples per lane transpose
+
+#include <cmath>
+#include "SIMD.h"
+#include "FastMath.h"
+#include "defines.h"
+
+// Plain values of one stream, bands LOW, MID, HHI, MAS.
+struct StreamSettings {
+    float at[4]   = { defat, defat, defat, defat };         // [ms]
+    float rt[4]   = { defrt, defrt, defrt, defrt };         // [ms]
+    float CT[4]   = { defCT, defCT, defCT, defCT };         // [dB]
+    float CR[4]   = { defCR, defCR, defCR, defCR };
+    float pre[4]  = { defpre, defpre, defpre, defpre };     // [dB]
+    float post[4] = { defpost, defpost, defpost, defpost }; // [dB]
+    float f0 = deff0;                                       // [Hz]
+    float f1 = deff1;
+};
+
+// Many independent streams in one object, without JUCE. Every channel of a
+// stream is a lane, four lanes run side by side in the float4 of a group,
+// so one pass over a group processes four channels at once. All state is
+// held per group as arrays of four (one value per lane).
+// Per lane: the 6 dB/oct allpass split (Crossover at SLOPE_6), the three
+// band compressors and the master compressor at full control rate, without
+// lookahead and limiter. Channels of a stereo stream are not linked, as in
+// the plugin.
+// The groups are allocated once for `maxLanes`; adding and removing streams
+// only claims or frees lanes and never moves the others.
+class BatchEngine {
+public:
+    //==================================================================
+    BatchEngine(int maxLanes, double sampleRate) :
+        numGroups((maxLanes + 3) / 4), fs(sampleRate)
+    {
+        if (maxLanes < 1) throw("empty engine");
+        if (sampleRate <= 0) throw("invalid sample rate");
+
+        groups = new Group[numGroups];
+        laneStream = new int[4 * numGroups];
+        laneChannel = new int[4 * numGroups];
+        streamLane = new int[2 * 4 * numGroups];
+        streamChannels = new int[4 * numGroups];
+        for (int lane = 0; lane < 4 * numGroups; lane++)
+        {
+            laneStream[lane] = -1;
+            laneChannel[lane] = 0;
+            streamChannels[lane] = 0;
+        }
+        for (int k = 0; k < numGroups; k++)
+        {
+            groups[k].active = 0;
+            for (int l = 0; l < 4; l++)
+                clearLane(groups[k], l);
+        }
+
+        rmsAttack = (float)(1 - std::exp(-1 / fs / RMS_A_TIME * 1000));
+        rmsRelease = (float)(1 - std::exp(-1 / fs / RMS_R_TIME * 1000));
+    }
+    ~BatchEngine()
+    {
+        delete[] groups;
+        delete[] laneStream;
+        delete[] laneChannel;
+        delete[] streamLane;
+        delete[] streamChannels;
+    }
+    BatchEngine(const BatchEngine&) = delete;
+    BatchEngine& operator=(const BatchEngine&) = delete;
+    //==================================================================
+    // Claims a lane per channel (1 or 2), starting from rest. Returns the
+    // id of the stream, -1 when there are not enough free lanes.
+    int addStream(int numChannels, const StreamSettings& settings)
+    {
+        if (numChannels < 1 || numChannels > 2) throw("mono or stereo streams only");
+
+        int id = -1;
+        for (int s = 0; s < 4 * numGroups && id < 0; s++)
+            if (streamChannels[s] == 0) id = s;
+        int lanes[2] = { -1, -1 };
+        for (int ch = 0; ch < numChannels; ch++)
+            lanes[ch] = findLane(ch > 0 ? lanes[0] : -1);
+        if (id < 0 || lanes[numChannels - 1] < 0) return -1;
+
+        streamChannels[id] = numChannels;
+        for (int ch = 0; ch < numChannels; ch++)
+        {
+            streamLane[2 * id + ch] = lanes[ch];
+            laneStream[lanes[ch]] = id;
+            laneChannel[lanes[ch]] = ch;
+            groups[lanes[ch] / 4].active++;
+        }
+        setSettings(id, settings);
+        return id;
+    }
+    void removeStream(int id)
+    {
+        if (id < 0 || id >= 4 * numGroups || streamChannels[id] == 0) return;
+
+        for (int ch = 0; ch < streamChannels[id]; ch++)
+        {
+            const int lane = streamLane[2 * id + ch];
+            laneStream[lane] = -1;
+            groups[lane / 4].active--;
+            clearLane(groups[lane / 4], lane % 4);
+        }
+        streamChannels[id] = 0;
+    }
+    // new values take effect at the next process(), the state carries on
+    void setSettings(int id, const StreamSettings& s)
+    {
+        if (id < 0 || id >= 4 * numGroups || streamChannels[id] == 0) return;
+
+        const double K0 = std::tan(M_PI * std::fmin(s.f0, 0.49 * fs) / fs);
+        const double K1 = std::tan(M_PI * std::fmin(s.f1, 0.49 * fs) / fs);
+        for (int ch = 0; ch < streamChannels[id]; ch++)
+        {
+            const int lane = streamLane[2 * id + ch];
+            Group& group = groups[lane / 4];
+            const int l = lane % 4;
+
+            group.c0[l] = (float)((K0 - 1) / (K0 + 1));
+            group.c1[l] = (float)((K1 - 1) / (K1 + 1));
+            for (int band = 0; band < 4; band++)
+            {
+                group.pre[band][l] = s.pre[band] == 0 ? 1.0f : fastmath::fast_db_to_gain(s.pre[band]);
+                group.post[band][l] = s.post[band] == 0 ? 1.0f : fastmath::fast_db_to_gain(s.post[band]);
+                group.CT[band][l] = s.CT[band];
+                group.slope[band][l] = 1 - 1 / s.CR[band];
+                group.cat[band][l] = (float)(1 - std::exp(-2.2 / fs / s.at[band] * 1000));
+                group.crt[band][l] = (float)(1 - std::exp(-2.2 / fs / s.rt[band] * 1000));
+            }
+        }
+    }
+    //==================================================================
+    // In place on the channel buffers of every stream: streams[id][channel]
+    // for ids below getMaxStreams(). Free ids and null entries are skipped,
+    // a stream without buffers sees silence.
+    void process(float* const* const* streams, int numSamples)
+    {
+       #if MBCOMP_SIMD_SSE
+        // flush denormals while the envelopes decay, as ScopedNoDenormals
+        const unsigned int csr = _mm_getcsr();
+        _mm_setcsr(csr | 0x8040);
+       #endif
+
+        alignas(16) float chunk[BATCH_CHUNK][4];
+        for (int k = 0; k < numGroups; k++)
+        {
+            Group& group = groups[k];
+            if (group.active == 0) continue;
+
+            float* lane[4];
+            for (int l = 0; l < 4; l++)
+            {
+                const int id = laneStream[4 * k + l];
+                lane[l] = id >= 0 && streams[id] != nullptr ? streams[id][laneChannel[4 * k + l]] : nullptr;
+            }
+
+            for (int pos = 0; pos < numSamples; pos += BATCH_CHUNK)
+            {
+                const int n = numSamples - pos < BATCH_CHUNK ? numSamples - pos : BATCH_CHUNK;
+                for (int i = 0; i < n; i++)
+                    for (int l = 0; l < 4; l++)
+                        chunk[i][l] = lane[l] != nullptr ? lane[l][pos + i] : 0.0f;
+
+                processGroup(group, chunk, n);
+
+                for (int l = 0; l < 4; l++)
+                    if (lane[l] != nullptr)
+                        for (int i = 0; i < n; i++)
+                            lane[l][pos + i] = chunk[i][l];
+            }
+        }
+
+       #if MBCOMP_SIMD_SSE
+        _mm_setcsr(csr);
+       #endif
+    }
+    //==================================================================
+    int getMaxStreams() const
+    {
+        return 4 * numGroups;
+    }
+    // 0 for a free id
+    int getNumChannels(int id) const
+    {
+        return id >= 0 && id < 4 * numGroups ? streamChannels[id] : 0;
+    }
+    int getNumFreeLanes() const
+    {
+        int free = 0;
+        for (int k = 0; k < numGroups; k++)
+            free += 4 - groups[k].active;
+        return free;
+    }
+
+private:
+    //==================================================================
+    // four lanes side by side, [band][lane] for the band fields
+    struct Group {
+        float c0[4], c1[4];             // allpass coefficients at f0, f1
+        float s0[4], s1[4];             // allpass states
+        float pre[4][4], post[4][4];    // linear
+        float CT[4][4];                 // [dB]
+        float slope[4][4];              // 1 - 1 / CR
+        float cat[4][4], crt[4][4];     // gain smoother
+        float xrms[4][4];               // detector
+        float g[4][4];                  // gain
+        int active;                     // lanes in use
+    };
+    //==================================================================
+    // One envelope step of a compressor for all lanes, returns the gain.
+    // Branch free form of Compressor::process(): the attack coefficient
+    // applies to rising and the release to falling differences.
+    static float4 gainStep(float4 x, float4& xrms, float4& g,
+                           float4 CT, float4 slope, float4 cat, float4 crt,
+                           float4 rmsAttack, float4 rmsRelease)
+    {
+        const float4 zero = float4::zero();
+        const float4 d = float4::abs(x) - xrms;
+        xrms = xrms + rmsAttack * float4::max(d, zero) + rmsRelease * float4::min(d, zero);
+
+        const float4 G = float4::min(slope * (CT - fastmath::fast_gain_to_db(xrms)), zero);
+        const float4 e = fastmath::fast_db_to_gain(G) - g;
+        g = g + cat * float4::min(e, zero) + crt * float4::max(e, zero);
+        return g;
+    }
+    void processGroup(Group& group, float (*x)[4], int n) const
+    {
+        const float4 half = float4::broadcast(0.5f);
+        const float4 ra = float4::broadcast(rmsAttack);
+        const float4 rr = float4::broadcast(rmsRelease);
+        const float4 c0 = float4::load(group.c0), c1 = float4::load(group.c1);
+        float4 s0 = float4::load(group.s0), s1 = float4::load(group.s1);
+
+        float4 pre[4], post[4], CT[4], slope[4], cat[4], crt[4], xrms[4], g[4];
+        for (int band = 0; band < 4; band++)
+        {
+            pre[band] = float4::load(group.pre[band]);
+            post[band] = float4::load(group.post[band]);
+            CT[band] = float4::load(group.CT[band]);
+            slope[band] = float4::load(group.slope[band]);
+            cat[band] = float4::load(group.cat[band]);
+            crt[band] = float4::load(group.crt[band]);
+            xrms[band] = float4::load(group.xrms[band]);
+            g[band] = float4::load(group.g[band]);
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            // LOW = (1 + A0) / 2, the f1 allpass splits the rest:
+            // MID = (1 + A1) u / 2, HHI = (1 - A1) u / 2, u = (1 - A0) / 2
+            const float4 in = float4::load(x[i]);
+            const float4 a0 = float4::mulAdd(c0, in, s0);
+            s0 = in - c0 * a0;
+            const float4 u = (in - a0) * half;
+            const float4 a1 = float4::mulAdd(c1, u, s1);
+            s1 = u - c1 * a1;
+            const float4 bands[3] = { (in + a0) * half, (u + a1) * half, (u - a1) * half };
+
+            float4 mix = float4::zero();
+            for (int band = 0; band < 3; band++)
+            {
+                const float4 y = bands[band] * pre[band];
+                const float4 gain = gainStep(y, xrms[band], g[band], CT[band], slope[band], cat[band], crt[band], ra, rr);
+                mix = float4::mulAdd(y * gain, post[band], mix);
+            }
+
+            const float4 m = mix * pre[MAS];
+            const float4 gain = gainStep(m, xrms[MAS], g[MAS], CT[MAS], slope[MAS], cat[MAS], crt[MAS], ra, rr);
+            (m * gain * post[MAS]).store(x[i]);
+        }
+
+        s0.store(group.s0);
+        s1.store(group.s1);
+        for (int band = 0; band < 4; band++)
+        {
+            xrms[band].store(group.xrms[band]);
+            g[band].store(group.g[band]);
+        }
+    }
+    //==================================================================
+    // lowest free lane, the one next to `beside` when that is free
+    int findLane(int beside) const
+    {
+        if (beside >= 0 && beside % 4 < 3 && laneStream[beside + 1] < 0)
+            return beside + 1;
+        for (int lane = 0; lane < 4 * numGroups; lane++)
+            if (laneStream[lane] < 0 && lane != beside)
+                return lane;
+        return -1;
+    }
+    // at rest, unity gain
+    static void clearLane(Group& group, int l)
+    {
+        group.c0[l] = group.c1[l] = 0;
+        group.s0[l] = group.s1[l] = 0;
+        for (int band = 0; band < 4; band++)
+        {
+            group.pre[band][l] = group.post[band][l] = 1;
+            group.CT[band][l] = 0;
+            group.slope[band][l] = 0;
+            group.cat[band][l] = group.crt[band][l] = 0;
+            group.xrms[band][l] = 0;
+            group.g[band][l] = 1;
+        }
+    }
+    //==================================================================
+    int numGroups;
+    double fs;
+    float rmsAttack, rmsRelease;    // detector, the same for every lane
+
+    Group* groups;
+    int* laneStream;        // stream of every lane, -1 when free
+    int* laneChannel;       // channel of the stream in every lane
+    int* streamLane;        // lanes of every stream id, 2 per id
+    int* streamChannels;    // channels of every stream id, 0 when free
+};
@@ -0,0 +1,298 @@
+/*
+  ==============================================================================
+
+    Compressor.h
+    Created: 4 Nov 2023 2:35:27pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#define BYPASS_GAIN 0.99999f    // gain counted as unity when entering bypass
+
+#include "SlidingMax.h"
+#include "Arena.h"
+#include "Decimator.h"
+#include "FastMath.h"
+#include "Parameters.h"
+#include "defines.h"
+#include "math.h"
+
+// Gain computer of one band. The detector runs on the undelayed signal and
+// the gain curve is written to GBuffer, the caller applies it to the audio
+// delayed by the lookahead time (one delay line for all bands).
+// Parameters are a plain struct owned by the caller, the coefficients
+// derived from them are recomputed only when they change.
+// A stereo pair is linked: one detector follows the louder of the two
+// sidechains and the one gain curve goes to both channels.
+class Compressor {
+public:
+    //==================================================================
+    Compressor(float* InputBuffer = nullptr, float* GainBuffer = nullptr) :
+        params(nullptr), IBuffer(InputBuffer), IBuffer2(nullptr), GBuffer(GainBuffer),
+        xrms(0), g(1), target(1), fs(0), grms(0),
+        interval(1), cubic(false), step(0), gPrev(1), gFrom(1), bypassed(false),
+        lastat(-1), lastrt(-1), lastCR(-1), lastPeriod(-1), lastFactor(-1),
+        cat(0), crt(0), rms_attack(0), rms_release(0), ratioSlope(0)
+    {
+    }
+    ~Compressor()
+    {
+    }
+    //==================================================================
+    void process(int BufferSize)
+    {
+        // the detector runs at fs / factor, the gain computer once every
+        // `interval` detector samples
+        const int factor = decimator.getFactor();
+        const int period = interval * factor;
+
+        // the detector sees the loudest sample still in the delay line
+        // (and the one leaving it), so the gain ramps before the peak is out;
+        // the decimator's group delay is already spent from the lookahead
+        int ahead = getLookahead() - decimator.getDelay();
+        peakHold.setWindow((ahead > 0 ? ahead : 0) / factor + 1);
+        grms = 0;
+
+        updateCoefficients(period, factor);
+
+        for (int i = 0; i < BufferSize; i++) {
+            float x;
+            if (IBuffer2 == nullptr ? decimator.push(IBuffer[i], x) : decimator.push(IBuffer[i], IBuffer2[i], x))
+            {
+                // smooth xrms function
+                float x2 = peakHold.push(x > 0 ? x : (-1 * x));
+                if (x2 > xrms)
+                    xrms = (1 - rms_attack) * xrms + rms_attack * x2;
+                else
+                    xrms = (1 - rms_release) * xrms + rms_release * x2;
+            }
+
+            // control rate: gain computer once per period
+            if (step == 0)
+            {
+                float X = fastmath::fast_gain_to_db(xrms);
+                // static compressor characteristic
+                float G = ratioSlope * (params->CT - X);
+                if (G > 0) G = 0;
+                target = fastmath::fast_db_to_gain(G);  // current gain target
+
+                gPrev = gFrom;
+                gFrom = g;
+                if (target < g)                    // attack / release ?
+                    g = (1 - cat) * g + cat * target; // we need to reduce less => attack
+                else
+                    g = (1 - crt) * g + crt * target; // we need to reduce more => release
+                step = period;
+            }
+            step--;
+
+            // audio rate: ramp from the previous control value to g,
+            // reaches g at the end of the period (t == 1)
+            float t = (float)(period - step) / period;
+            float gain = cubic ? hermite(t) : gFrom + (g - gFrom) * t;
+            if (gain > 1) gain = 1;
+
+            GBuffer[i] = gain;
+            grms += (gain * gain);
+        }
+        grms /= BufferSize;
+        grms = sqrt(grms);
+    }
+    // Ratio 1 makes the band a no-op. Once the gain has released to unity
+    // the band is bypassed: process() can be skipped and the gain is 1.
+    // Leaving the bypass restarts the detector from rest, so the gain
+    // ramps in at the attack time. Call once per block.
+    bool updateBypass()
+    {
+        const bool noop = params->CR <= 1.0f;
+        if (bypassed && !noop)
+        {
+            resume();
+            bypassed = false;
+        }
+        else if (!bypassed && noop && g >= BYPASS_GAIN && gFrom >= BYPASS_GAIN)
+            bypassed = true;
+
+        if (bypassed) grms = 1;
+        return bypassed;
+    }
+    void clearIn(int BufferSize)
+    {
+        for (int i = 0; i < BufferSize; i++)
+            IBuffer[i] = 0;
+    }
+    //==================================================================
+    float* getInputBuffer() const
+    {
+        return IBuffer;
+    }
+    float* getGainBuffer() const
+    {
+        return GBuffer;
+    }
+    // lookahead delay the caller has to apply to the audio [samples]
+    int getLookahead() const
+    {
+        if (params == nullptr) return 0;
+        return (int)(params->la * fs / 1000);
+    }
+    float getGRMS() const
+    {
+        return grms;
+    }
+    //==================================================================
+    // `linkedPointer` is the second channel's sidechain of a linked pair
+    void setInputBuffer(float* bufferPointer, float* linkedPointer = nullptr)
+    {
+        IBuffer = bufferPointer;
+        IBuffer2 = linkedPointer;
+    }
+    void setGainBuffer(float* bufferPointer)
+    {
+        GBuffer = bufferPointer;
+    }
+    void setParameters(const CompressorParameters* parameters)
+    {
+        params = parameters;
+    }
+    // static characteristic (hard knee): gain in dB at the input level
+    // `inputDb`, for displays
+    static float getStaticGain(float inputDb, float threshold, float ratio)
+    {
+        float G = (1 - 1 / ratio) * (threshold - inputDb);
+        return G > 0 ? 0 : G;
+    }
+    // Gain computer runs once every `samples` samples, the gain is
+    // interpolated in between (linear or cubic). 1 is full rate.
+    void setInterval(int samples, bool cubicInterpolation = false)
+    {
+        if (samples < 1) samples = 1;
+        interval = samples;
+        cubic = cubicInterpolation;
+        if (step > interval * decimator.getFactor())
+            step = interval * decimator.getFactor();
+    }
+    int getInterval() const
+    {
+        return interval;
+    }
+    // Detector and gain computer run on the sidechain decimated by `factor`
+    // (1 is full rate). Only meant for band-limited sidechains; the
+    // decimator's group delay is taken from the lookahead, so the caller
+    // keeps Decimator::delayFor(factor) <= getLookahead().
+    void setDecimation(int factor)
+    {
+        if (factor == decimator.getFactor()) return;
+
+        decimator.setFactor(factor);
+        peakHold.clear();
+        step = 0;
+    }
+    int getDecimation() const
+    {
+        return decimator.getFactor();
+    }
+    // The peak hold storage comes from `arena` when given, see
+    // getArenaBytes().
+    void setfs(double SampleRate, Arena* arena = nullptr)
+    {
+        if (fs < 0) throw("negative sample rate");
+
+        fs = SampleRate;
+        lastPeriod = lastFactor = -1;   // time coefficients follow fs
+        const int capacity = getPeakHoldSize(fs);
+        if (arena != nullptr)
+            peakHold.setStorage(arena->allocate<float>(capacity), arena->allocate<unsigned int>(capacity), capacity);
+        else
+            peakHold.resize(capacity);
+    }
+    static size_t getArenaBytes(double SampleRate)
+    {
+        const int capacity = getPeakHoldSize(SampleRate);
+        return Arena::bytes<float>(capacity) + Arena::bytes<unsigned int>(capacity);
+    }
+
+private:
+    //==================================================================
+    void updateCoefficients(int period, int factor)
+    {
+        if (params->at != lastat || params->rt != lastrt || period != lastPeriod)
+        {
+            // TIME COEFFS, *1000 bc of [ms]
+            // the gain smoother steps once per period
+            cat = 1 - exp(-2.2 * period / fs / params->at * 1000);
+            crt = 1 - exp(-2.2 * period / fs / params->rt * 1000);
+            lastat = params->at;
+            lastrt = params->rt;
+            lastPeriod = period;
+        }
+        if (factor != lastFactor)
+        {
+            const double fsd = fs / factor;
+            rms_attack = 1 - exp(-1 / fsd / RMS_A_TIME * 1000);
+            rms_release = 1 - exp(-1 / fsd / RMS_R_TIME * 1000);
+            lastFactor = factor;
+        }
+        if (params->CR != lastCR)
+        {
+            ratioSlope = 1 - 1 / params->CR;
+            lastCR = params->CR;
+        }
+    }
+    void resume()
+    {
+        xrms = 0;
+        g = target = gPrev = gFrom = 1;
+        step = 0;
+        peakHold.clear();
+        decimator.reset();
+    }
+    static int getPeakHoldSize(double SampleRate)
+    {
+        return (int)(maxla * SampleRate / 1000 + 2);
+    }
+    // Hermite segment from gFrom to g, the tangents are estimated from the
+    // control values already known, so it does not add any delay.
+    float hermite(float t) const
+    {
+        float m1 = (g - gPrev) / 2;
+        float m2 = g - gFrom;
+        float t2 = t * t;
+        float t3 = t2 * t;
+        return (2 * t3 - 3 * t2 + 1) * gFrom + (t3 - 2 * t2 + t) * m1
+             + (-2 * t3 + 3 * t2) * g + (t3 - t2) * m2;
+    }
+    //==================================================================
+    const CompressorParameters* params;
+
+    float*                  IBuffer;
+    float*                  IBuffer2;    // linked channel, nullptr for one
+    float*                  GBuffer;
+    SlidingMax<float>       peakHold;    // max |x| over the lookahead window
+    Decimator               decimator;   // sidechain resampling for the detector
+
+    float xrms;
+    float g;
+    float target;
+
+    double fs;
+    float grms;
+
+    // control rate
+    int interval;
+    bool cubic;
+    int step;       // samples left until the next gain computation
+    float gPrev;    // control values before g
+    float gFrom;
+    bool bypassed;
+
+    // cached coefficients and what they were computed from
+    float lastat, lastrt, lastCR;
+    int lastPeriod, lastFactor;
+    float cat, crt;                 // gain smoother, per period
+    float rms_attack, rms_release;  // detector, per detector sample
+    float ratioSlope;               // 1 - 1 / CR
+};
\ No newline at end of file
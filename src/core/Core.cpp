@@ -0,0 +1,28 @@
+/*
+  ==============================================================================
+
+    Core.cpp
+    Created: 20 Oct 2026 1:32:18am
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+// The core is header only apart from the kernels. Every header is included
+// here, so building MBCompCore (no JUCE on its include path) checks that
+// none of them needs JUCE.
+
+#include "Parameters.h"
+#include "Allpass.h"
+#include "Compressor.h"
+#include "Crossover.h"
+#include "Decimator.h"
+#include "Fade.h"
+#include "BatchEngine.h"
+#include "Arena.h"
+#include "CircularBuffer.h"
+#include "EventQueue.h"
+#include "SlidingMax.h"
+#include "FastMath.h"
+#include "SIMD.h"
+#include "Kernels.h"
@@ -0,0 +1,250 @@
+/*
+  ==============================================================================
+
+    Crossover.h
+    Created: 19 Oct 2026 6:12:37pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#define _USE_MATH_DEFINES
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include "Kernels.h"
+#include "Parameters.h"
+#include "defines.h"
+
+// Three band crossover on a cascade of transposed direct form II biquads.
+// Every band is its own chain of sections and the chains run side by side in
+// the lanes of a float4 (LOW, MID, HHI, unused), so one cascade pass per
+// sample yields all bands (KernelTable::crossover). Linkwitz-Riley topology:
+//   LOW = LP0 * AP1,  MID = HP0 * LP1,  HHI = HP0 * HP1
+// AP1 is the allpass LP1 + HP1, so the bands sum to AP0 * AP1 (flat
+// magnitude). At 6 dB/oct the bands are the legacy allpass complementary
+// filters, one section each, and sum to the input exactly.
+// One object splits a mono or a stereo signal: the state of the second
+// channel sits next to the first in every section.
+class Crossover {
+public:
+    //==================================================================
+    Crossover() :
+        params(nullptr), fs(0),
+        stages(1), tail(0), lastf0(-1), lastf1(-1), lastSlope(-1), lastfs(-1),
+        kernel(&kernels::get())
+    {
+        for (int s = 0; s < CX_MAX_STAGES; s++)
+            for (int l = 0; l < 4; l++)
+                setSection(s, l, 1, 0, 0, 0, 0);
+        reset();
+    }
+    ~Crossover()
+    {
+    }
+    //==================================================================
+    // Writes the bands of `input` to bands[0..2]. The input may not alias
+    // the bands.
+    void process(const float* input, float** bands, int BufferSize)
+    {
+        updateCoefficients();
+
+        kernel->crossover(input, bands, BufferSize, coef, state, stages);
+    }
+    // Both channels of input[0..1] into bands[0..1][0..2], one pass.
+    void process(const float* const* input, float** const* bands, int BufferSize)
+    {
+        updateCoefficients();
+
+        kernel->crossoverStereo(input, bands, BufferSize, coef, state, stages);
+    }
+    void reset()
+    {
+        for (int s = 0; s < CX_MAX_STAGES; s++)
+            for (int l = 0; l < 8; l++)
+                state[s][0][l] = state[s][1][l] = 0;
+    }
+    int getStages() const
+    {
+        return stages;
+    }
+    // samples for the slowest pole to ring down to IDLE_LEVEL, as of the
+    // last processed block
+    int getTailSamples() const
+    {
+        return tail;
+    }
+    // complex response of the bands at `freq` [Hz] for the current
+    // settings, for displays (not while process() runs on another thread)
+    void getResponse(double freq, std::complex<double>* bands)
+    {
+        updateCoefficients();
+
+        const std::complex<double> z1 = std::polar(1.0, -2 * M_PI * freq / fs);
+        const std::complex<double> z2 = z1 * z1;
+        for (int l = 0; l < 3; l++)
+        {
+            bands[l] = 1;
+            for (int s = 0; s < stages; s++)
+                bands[l] *= ((double)coef[s][0][l] + (double)coef[s][1][l] * z1 + (double)coef[s][2][l] * z2)
+                          / (1.0 + (double)coef[s][3][l] * z1 + (double)coef[s][4][l] * z2);
+        }
+    }
+    //==================================================================
+    void setParameters(const CrossoverParameters* parameters)
+    {
+        params = parameters;
+    }
+    void setfs(float sampleRate)
+    {
+        fs = sampleRate;
+    }
+
+private:
+    //==================================================================
+    // Recomputes the sections only when a frequency, the slope or the
+    // sample rate changed since the last block.
+    void updateCoefficients()
+    {
+        const float e0 = params->f0, e1 = params->f1;
+        const int order = (int)params->slope;
+        if (e0 == lastf0 && e1 == lastf1 && order == lastSlope && fs == lastfs)
+            return;
+
+        if (order != lastSlope)
+            reset();
+        lastf0 = e0;
+        lastf1 = e1;
+        lastSlope = order;
+        lastfs = fs;
+
+        const double K0 = std::tan(M_PI * std::min(e0, 0.49f * fs) / fs);
+        const double K1 = std::tan(M_PI * std::min(e1, 0.49f * fs) / fs);
+
+        for (int s = 0; s < CX_MAX_STAGES; s++)
+            for (int l = 0; l < 4; l++)
+                setSection(s, l, 1, 0, 0, 0, 0);
+
+        switch (order)
+        {
+        case SLOPE_6:
+        {
+            // allpass c + z^-1 / 1 + c z^-1, the bands of the legacy split
+            // (the f1 allpass filters the upper half of the f0 split):
+            //   (1 + A0)/2,  (1 - A0)(1 + A1)/4,  (1 - A0)(1 - A1)/4
+            // The products are expanded, so no section waits for another.
+            const double c0 = (K0 - 1) / (K0 + 1), c1 = (K1 - 1) / (K1 + 1);
+            const double mid = (1 - c0) * (1 + c1) / 4, high = (1 - c0) * (1 - c1) / 4;
+            setSection(0, 0, (1 + c0) / 2, (1 + c0) / 2, 0, c0, 0);
+            setSection(0, 1, mid, 0, -mid, c0 + c1, c0 * c1);
+            setSection(0, 2, high, -2 * high, high, c0 + c1, c0 * c1);
+            stages = 1;
+            break;
+        }
+        case SLOPE_LR2:
+        {
+            // squared first order sections, the highpass is inverted so
+            // LP - HP is the first order allpass
+            stages = 2;
+            setLR2(0, 0, K0, LP);  setLR2(1, 0, K1, AP);
+            setLR2(0, 1, K0, HP);  setLR2(1, 1, K1, LP);
+            setLR2(0, 2, K0, HP);  setLR2(1, 2, K1, HP);
+            break;
+        }
+        default:
+        {
+            // squared Butterworth, the allpass has the same poles
+            static const double q4[] = { 0.70710678 };
+            static const double q8[] = { 0.54119610, 1.30656296 };
+            const double* q = order == SLOPE_LR4 ? q4 : q8;
+            const int n = order == SLOPE_LR4 ? 1 : 2;   // sections per Butterworth
+            stages = 4 * n;
+
+            for (int k = 0; k < 2 * n; k++)
+            {
+                setBiquad(k, 0, K0, q[k % n], LP);
+                setBiquad(k, 1, K0, q[k % n], HP);
+                setBiquad(k, 2, K0, q[k % n], HP);
+                setBiquad(2 * n + k, 1, K1, q[k % n], LP);
+                setBiquad(2 * n + k, 2, K1, q[k % n], HP);
+            }
+            for (int k = 0; k < n; k++)
+                setBiquad(2 * n + k, 0, K1, q[k], AP);
+            break;
+        }
+        }
+
+        tail = decaySamples();
+    }
+    int decaySamples() const
+    {
+        double r = 0;
+        for (int s = 0; s < stages; s++)
+            for (int l = 0; l < 3; l++)
+            {
+                // largest pole radius of 1 + a1 z^-1 + a2 z^-2
+                const double a1 = coef[s][3][l], a2 = coef[s][4][l];
+                const double disc = a1 * a1 - 4 * a2;
+                r = std::max(r, disc < 0 ? std::sqrt(a2) : (std::fabs(a1) + std::sqrt(disc)) / 2);
+            }
+        if (r <= 0 || r >= 1) return 0;
+        return (int)std::ceil(std::log(IDLE_LEVEL) / std::log(r));
+    }
+    //==================================================================
+    enum Type { LP, HP, AP };
+
+    // second order section with prewarped K = tan(pi f / fs)
+    void setBiquad(int s, int lane, double K, double Q, Type type)
+    {
+        const double norm = 1 / (1 + K / Q + K * K);
+        const double a1 = 2 * (K * K - 1) * norm;
+        const double a2 = (1 - K / Q + K * K) * norm;
+
+        if (type == LP)      setSection(s, lane, K * K * norm, 2 * K * K * norm, K * K * norm, a1, a2);
+        else if (type == HP) setSection(s, lane, norm, -2 * norm, norm, a1, a2);
+        else                 setSection(s, lane, a2, a1, 1, a1, a2);
+    }
+    // LR2 lowpass / inverted highpass as one squared first order section,
+    // the allpass is first order
+    void setLR2(int s, int lane, double K, Type type)
+    {
+        const double a = (K - 1) / (K + 1);
+
+        if (type == LP)
+        {
+            const double k = K / (1 + K);
+            setSection(s, lane, k * k, 2 * k * k, k * k, 2 * a, a * a);
+        }
+        else if (type == HP)
+        {
+            const double h = 1 / (1 + K);
+            setSection(s, lane, -h * h, 2 * h * h, -h * h, 2 * a, a * a);
+        }
+        else setSection(s, lane, a, 1, 0, a, 0);
+    }
+    void setSection(int s, int lane, double b0, double b1, double b2, double a1, double a2)
+    {
+        coef[s][0][lane] = (float)b0;
+        coef[s][1][lane] = (float)b1;
+        coef[s][2][lane] = (float)b2;
+        coef[s][3][lane] = (float)a1;
+        coef[s][4][lane] = (float)a2;
+    }
+    //==================================================================
+    const CrossoverParameters* params;
+    float fs;
+
+    int stages;
+    int tail;
+    float coef[CX_MAX_STAGES][5][4];    // b0 b1 b2 a1 a2, one lane per band
+    float state[CX_MAX_STAGES][2][8];   // s1 s2, channel 0 lanes then channel 1
+
+    float lastf0, lastf1;
+    int lastSlope;
+    float lastfs;
+
+    const KernelTable* kernel;
+};
@@ -0,0 +1,175 @@
+/*
+  ==============================================================================
+
+    Decimator.h
+    Created: 19 Oct 2026 3:48:23pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#define _USE_MATH_DEFINES
+
+#define MAX_DECIMATION  16
+#define DEC_TAPS        8       // taps per decimated sample
+
+#include <algorithm>
+#include <cmath>
+
+static_assert((MAX_DECIMATION & (MAX_DECIMATION - 1)) == 0, "MAX_DECIMATION must be a power of two");
+
+// Anti-aliased downsampler for detector sidechains. Only every factor-th
+// output is computed, so the cost is DEC_TAPS multiply-adds per input sample
+// whatever the factor is. The filters of every power of two factor are
+// designed in the constructor, setFactor() only selects one and clears the
+// history (no allocation, no trigonometry, safe on the audio thread).
+// A linked stereo detector pushes both channels: the histories are
+// interleaved and the output is the larger magnitude of the two.
+class Decimator {
+public:
+    //==================================================================
+    Decimator() : factor(1), length(1), offset(0), pos(0), phase(0)
+    {
+        int o = 0;
+        for (int f = 1; f <= MAX_DECIMATION; f *= 2)
+        {
+            design(taps + o, f);
+            o += lengthFor(f);
+        }
+        reset();
+    }
+    ~Decimator()
+    {
+    }
+    //==================================================================
+    // Returns true and writes `output` once every factor samples.
+    bool push(float input, float& output)
+    {
+        if (factor == 1)
+        {
+            output = input;
+            return true;
+        }
+
+        pos = (pos == 0) ? length - 1 : pos - 1;
+        hist[pos] = hist[pos + length] = input;
+
+        if (++phase < factor)
+            return false;
+        phase = 0;
+
+        const float* h = taps + offset;
+        float acc = 0;
+        for (int j = 0; j < length; j++)
+            acc += h[j] * hist[pos + j];
+        output = acc;
+        return true;
+    }
+    // Two channels, `output` is max(|left|, |right|) after the filter.
+    // Don't mix with the one channel push() without a reset().
+    bool push(float left, float right, float& output)
+    {
+        if (factor == 1)
+        {
+            output = std::max(std::fabs(left), std::fabs(right));
+            return true;
+        }
+
+        pos = (pos == 0) ? length - 1 : pos - 1;
+        hist[2 * pos] = hist[2 * (pos + length)] = left;
+        hist[2 * pos + 1] = hist[2 * (pos + length) + 1] = right;
+
+        if (++phase < factor)
+            return false;
+        phase = 0;
+
+        const float* h = taps + offset;
+        const float* x = hist + 2 * pos;
+        float accL = 0, accR = 0;
+        for (int j = 0; j < length; j++)
+        {
+            accL += h[j] * x[2 * j];
+            accR += h[j] * x[2 * j + 1];
+        }
+        output = std::max(std::fabs(accL), std::fabs(accR));
+        return true;
+    }
+    // group delay of the filter [input samples]
+    int getDelay() const
+    {
+        return delayFor(factor);
+    }
+    int getFactor() const
+    {
+        return factor;
+    }
+    //==================================================================
+    // Rounds down to a power of two.
+    void setFactor(int f)
+    {
+        if (f > MAX_DECIMATION) f = MAX_DECIMATION;
+        factor = 1;
+        offset = 0;
+        while (factor * 2 <= f)
+        {
+            offset += lengthFor(factor);
+            factor *= 2;
+        }
+        length = lengthFor(factor);
+
+        reset();
+    }
+    void reset()
+    {
+        for (int k = 0; k < 4 * length; k++)
+            hist[k] = 0;
+        pos = 0;
+        phase = 0;
+    }
+    //==================================================================
+    static int lengthFor(int f)
+    {
+        return f == 1 ? 1 : DEC_TAPS * f + 1;
+    }
+    // group delay at factor `f`, the caller keeps it within the lookahead
+    static int delayFor(int f)
+    {
+        return (lengthFor(f) - 1) / 2;
+    }
+
+private:
+    //==================================================================
+    // Windowed sinc lowpass at 0.9 x the decimated Nyquist frequency.
+    static void design(float* h, int f)
+    {
+        const int n = lengthFor(f);
+        const double fc = 0.9 * 0.5 / f;     // [cycles / sample]
+        const int center = (n - 1) / 2;
+        double sum = 0;
+        for (int k = 0; k < n; k++)
+        {
+            double t = k - center;
+            double sinc = (k == center) ? 2 * fc : std::sin(2 * M_PI * fc * t) / (M_PI * t);
+            double w = n == 1 ? 1 : 0.42 - 0.5 * std::cos(2 * M_PI * k / (n - 1))
+                                      + 0.08 * std::cos(4 * M_PI * k / (n - 1));
+            h[k] = (float)(sinc * w);
+            sum += h[k];
+        }
+        for (int k = 0; k < n; k++)
+            h[k] /= (float)sum;
+    }
+
+    //==================================================================
+    int factor;
+    int length;
+    int offset;     // of the current filter in taps
+    int pos;
+    int phase;
+
+    // all power of two filters back to back, DEC_TAPS x (2 + 4 + ...) plus
+    // one center tap each (bounded by MAX_DECIMATION filters)
+    float taps[DEC_TAPS * (2 * MAX_DECIMATION - 2) + MAX_DECIMATION];
+    float hist[4 * (DEC_TAPS * MAX_DECIMATION + 1)];    // mirrored history (x2 for two channels)
+};
@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    Fade.h
+    Created: 19 Oct 2026 11:21:40pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Linear gain ramp towards a target over a fixed number of samples. Every
+// channel of a piece has to see the same ramp, so render() writes the values
+// of a piece once and advances the fade by the whole piece.
+class Fade {
+public:
+    //==================================================================
+    Fade(float initial = 1) : value(initial), target(initial), step(0), length(1)
+    {
+    }
+    ~Fade()
+    {
+    }
+    //==================================================================
+    // every change of the target takes `samples`
+    void setLength(int samples)
+    {
+        length = samples > 1 ? samples : 1;
+    }
+    void setTarget(float newTarget)
+    {
+        target = newTarget;
+        step = (target - value) / length;
+        if (step == 0) value = target;
+    }
+    // no ramp, the value is the target at once
+    void jump(float newTarget)
+    {
+        value = target = newTarget;
+        step = 0;
+    }
+    //==================================================================
+    bool isFading() const
+    {
+        return value != target;
+    }
+    float getValue() const
+    {
+        return value;
+    }
+    float getTarget() const
+    {
+        return target;
+    }
+    // samples until the target is reached
+    int getRemaining() const
+    {
+        if (!isFading()) return 0;
+        return (int)((target - value) / step) + 1;
+    }
+    // Writes the next n values to out and advances. Returns false and writes
+    // nothing when the value is constant (getValue()).
+    bool render(float* out, int n)
+    {
+        if (!isFading()) return false;
+
+        for (int i = 0; i < n; i++)
+        {
+            value += step;
+            if ((step > 0 && value >= target) || (step < 0 && value <= target))
+            {
+                value = target;
+                step = 0;
+            }
+            out[i] = value;
+        }
+        return true;
+    }
+
+private:
+    //==================================================================
+    float value;
+    float target;
+    float step;
+    int length;
+};
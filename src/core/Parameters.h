@@ -0,0 +1,33 @@
+/*
+  ==============================================================================
+
+    Parameters.h
+    Created: 20 Oct 2026 1:05:52am
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "defines.h"
+
+// Plain values the DSP core reads, in the units of defines.h. The caller
+// owns them and changes them between blocks; the processors recompute their
+// coefficients when they see a new value.
+
+// one band compressor
+struct CompressorParameters {
+    float at = defat;   // [ms]
+    float rt = defrt;   // [ms]
+    float la = defla;   // [ms] lookahead, the caller delays the audio
+    float CT = defCT;   // [dB]
+    float CR = defCR;
+};
+
+// three band split, slope is a SLOPE_* choice index
+struct CrossoverParameters {
+    float f0 = deff0;   // [Hz]
+    float f1 = deff1;   // [Hz]
+    float slope = defslope;
+};
@@ -18,6 +18,7 @@
 #define minpre    -20.0f
 #define minla       0.0f
 #define minf       30.0f
+#define minceil   -20.0f
 
 #define maxat    2600.0f
 #define maxrt    5000.0f
@@ -27,6 +28,7 @@
 #define maxpre     40.0f
 #define maxla      50.0f
 #define maxf    15000.0f
+#define maxceil     0.0f
 
 #define defat       1.0f
 #define defrt      50.0f
@@ -37,13 +39,46 @@
 #define defla      10.0f
 #define deff0     500.0f
 #define deff1   10000.0f
+#define defceil    -1.0f
+#define deftp       false
+#define defquality  QHIGH
+#define defmultirate false
+#define defmode     MODE_CROSSOVER
+#define defbands   32
+#define defslope   SLOPE_LR4
 
 #define MAS         3
 #define LOW         0
 #define MID         1
 #define HHI         2
 
+#define QECO        0
+#define QNORMAL     1
+#define QHIGH       2
+
+#define MODE_CROSSOVER  0
+#define MODE_SPECTRAL   1
+
+#define SLOPE_6         0   // legacy first order crossover, old states load it
+#define SLOPE_LR2       1
+#define SLOPE_LR4       2
+#define SLOPE_LR8       3
+
+#define RMS_A_TIME      5       // [ms] detector attack and release
+#define RMS_R_TIME      130
+
+#define IDLE_LEVEL      1e-6f   // -120 dBFS, silence for the idle detection
+#define IDLE_SETTLE     14      // envelope time constants to decay by 120 dB
+
 #define CHAR_W     15
 #define CHAR_H     15
+#define METER_FPS  30   // meter updates per second, at most
+#define RESPONSE_H 120  // height of the curve display
+#define EDITOR_W   500  // base size, the editor scales it
+#define EDITOR_H   (305 + RESPONSE_H)
+
+#define FILMSTRIP_FRAMES 128    // knob positions per strip
+#define FILMSTRIP_STEP   8      // [px] strip sizes are rounded up to this
+#define FILMSTRIP_MAX    24     // strips kept, least recently used go first
 
 #define BG_COLOUR juce::Colours::darkcyan.withBrightness(0.25).withSaturation(0.25)
\ No newline at end of file
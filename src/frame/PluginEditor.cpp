@@ -12,16 +12,31 @@
 
 //==============================================================================
 MBComp01AudioProcessorEditor::MBComp01AudioProcessorEditor (MBComp01AudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p), body(p)
+    : AudioProcessorEditor (&p), audioProcessor (p), body(p), showDiagnostics(false)
 {
+    setLookAndFeel(&lookAndFeel);
+
     head.setText(HEADER_TEXT);
+    // hidden: double click on the header shows the active DSP kernels
+    head.onDoubleClick = [this]
+        {
+            showDiagnostics = !showDiagnostics;
+            juce::String text = showDiagnostics ? "Kernels: " + audioProcessor.getKernelName() : HEADER_TEXT;
+            head.setText(text);
+            head.repaint();
+        };
     addAndMakeVisible(head);
     addAndMakeVisible(body);
 
-    setSize (500, 305);
+    // any size with the base aspect ratio, the content is scaled
+    setResizable(true, true);
+    setResizeLimits(EDITOR_W / 2, EDITOR_H / 2, EDITOR_W * 4, EDITOR_H * 4);
+    getConstrainer()->setFixedAspectRatio((double)EDITOR_W / EDITOR_H);
+    setSize (EDITOR_W, EDITOR_H);
 }
 MBComp01AudioProcessorEditor::~MBComp01AudioProcessorEditor()
 {
+    setLookAndFeel(nullptr);
 }
 //==============================================================================
 void MBComp01AudioProcessorEditor::paint (juce::Graphics& g)
@@ -30,8 +45,14 @@ void MBComp01AudioProcessorEditor::paint (juce::Graphics& g)
 }
 void MBComp01AudioProcessorEditor::resized()
 {
-    auto area = getLocalBounds();
+    // laid out at the base size, then scaled to the editor: fonts, strokes
+    // and cached images follow the scale
+    auto area = juce::Rectangle<int>(EDITOR_W, EDITOR_H);
     area.removeFromBottom(5.0f);
     head.setBounds(area.removeFromTop(30.0f));
     body.setBounds(area);
+
+    auto scale = juce::AffineTransform::scale((float)getWidth() / EDITOR_W);
+    head.setTransform(scale);
+    body.setTransform(scale);
 }
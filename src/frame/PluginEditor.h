@@ -32,8 +32,10 @@ private:
     // access the processor object that created it.
     MBComp01AudioProcessor& audioProcessor;
 
+    knobLookAndFeel lookAndFeel;
     headComponent head;
     bodyComponent body;
+    bool showDiagnostics;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MBComp01AudioProcessorEditor)
 };
\ No newline at end of file
@@ -9,6 +9,57 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 #include "defines.h"
+#include <limits>
+
+// the instance whose swapPreset() is writing the parameters on this thread,
+// its own notifications are not queued (other threads' automation is)
+static thread_local const MBComp01AudioProcessor* presetWriter = nullptr;
+
+//==============================================================================
+// gain computer rate of the compressors per quality tier
+static const struct { int interval; bool cubic; } qualityTiers[] =
+{
+    { 32, false },  // QECO
+    {  8, true  },  // QNORMAL
+    {  1, false },  // QHIGH, full rate
+};
+
+// Largest power of two decimation that keeps the band edge below a quarter
+// of the decimated Nyquist frequency and whose anti-alias filter delay fits
+// in the lookahead (the gain must not lag the delayed audio).
+static int decimationFor(double sampleRate, float edge, int lookahead)
+{
+    int factor = 1;
+    while (factor * 2 <= MAX_DECIMATION && sampleRate / (factor * 2) >= 8 * edge
+        && Decimator::delayFor(factor * 2) <= lookahead)
+        factor *= 2;
+    return factor;
+}
+
+// Band parameters in registration order, the host sees them by index. The
+// IDs are also the attribute names of the saved state.
+static const struct {
+    const char* id[4];      // LOW, MID, HHI, MAS
+    const char* name[4];
+    float min, max, def;
+} bandParameters[] =
+{
+    { { "atLow", "atMid", "atHigh", "atMaster" },
+      { "LowAttack Time", "MidAttack Time", "HighAttack Time", "MasterAttack Time" }, minat, maxat, defat },
+    { { "rtLow", "rtMid", "rtHigh", "rtMaster" },
+      { "LowRelease Time", "MidRelease Time", "HighRelease Time", "MasterRelease Time" }, minat, maxat, defrt },
+    { { "CTLow", "CTMid", "CTHigh", "CTMaster" },
+      { "LowTreshold", "MidTreshold", "HighTreshold", "MasterTreshold" }, minCT, maxCT, defCT },
+    { { "CRLow", "CRMid", "CRHigh", "CRMaster" },
+      { "LowRatio", "MidRatio", "HighRatio", "MasterRatio" }, minCR, maxCR, defCR },
+    { { "postLow", "postMid", "postHigh", "postMaster" },
+      { "LowPost Compression Gain", "MidPost Compression Gain", "HighPost Compression Gain", "MasterPost Compression Gain" },
+      minpost, maxpost, defpost },
+    { { "preLow", "preMid", "preHigh", "preMaster" },
+      { "LowPre Compression Gain", "MidPre Compression Gain", "HighPre Compression Gain", "MasterPre Compression Gain" },
+      minpre, maxpre, defpre },
+};
+#define NUM_BAND_PARAMETERS (int)(sizeof(bandParameters) / sizeof(bandParameters[0]))
 
 //==============================================================================
 MBComp01AudioProcessor::MBComp01AudioProcessor()
@@ -22,46 +73,34 @@ MBComp01AudioProcessor::MBComp01AudioProcessor()
 #endif
     ),
 #endif
-    comps(nullptr), filters(nullptr),
-    gLvl(new float[4]), iLvl(new float[4]), oLvl(new float[4]),
-    supportBuffer(nullptr), supportBufferSize(0), solo(MAS),
-    at(new   juce::AudioParameterFloat* [4]),
-    rt(new   juce::AudioParameterFloat* [4]),
-    CT(new   juce::AudioParameterFloat* [4]),
-    CR(new   juce::AudioParameterFloat* [4]),
-    pre(new  juce::AudioParameterFloat* [4]),
-    post(new juce::AudioParameterFloat* [4])
-{
-    std::string bandName;
+    plain(nullptr), applied(nullptr), numParams(0), events(PARAM_QUEUE_SIZE), eventsLost(false), numBindings(0),
+    commands(CMD_QUEUE_SIZE), retired(2 * CMD_QUEUE_SIZE),
+    solo(MAS), meterSubscribers(0), pendingPreset(nullptr), outCurve(nullptr),
+    comps(nullptr), filters(nullptr), delays(nullptr),
+    spectral(nullptr), spectralReady(nullptr), spectralBytes(0), spectralActive(false), groupSize(1),
+    supportBuffer(nullptr), sideBuffer(nullptr), gainBuffer(nullptr),
+    supportBufferSize(0), silentSamples(0), kernel(&kernels::baseline)
+{
+    // same order as bandParameters
+    juce::AudioParameterFloat** const slots[NUM_BAND_PARAMETERS] = { at, rt, CT, CR, post, pre };
     for (int band = 0; band < 4; band++)
     {
-        switch (band)
+        for (int k = 0; k < NUM_BAND_PARAMETERS; k++)
         {
-        case LOW: bandName = "Low"; break;
-        case MID: bandName = "Mid"; break;
-        case HHI: bandName = "High"; break;
-        case MAS: bandName = "Master"; break;
-        default: bandName = "ERROR";
+            const auto& row = bandParameters[k];
+            MBComp01AudioProcessor::addParameter(slots[k][band] =
+                new juce::AudioParameterFloat(row.id[band], row.name[band], row.min, row.max, row.def));
         }
 
-        MBComp01AudioProcessor::addParameter(at[band] =
-            new juce::AudioParameterFloat("at" + bandName, bandName + "Attack Time", minat, maxat, defat));
-        MBComp01AudioProcessor::addParameter(rt[band] =
-            new juce::AudioParameterFloat("rt" + bandName, bandName + "Release Time", minat, maxat, defrt));
-        MBComp01AudioProcessor::addParameter(CT[band] =
-            new juce::AudioParameterFloat("CT" + bandName, bandName + "Treshold", minCT, maxCT, defCT));
-        MBComp01AudioProcessor::addParameter(CR[band] =
-            new juce::AudioParameterFloat("CR" + bandName, bandName + "Ratio", minCR, maxCR, defCR));
-
-        MBComp01AudioProcessor::addParameter(post[band] =
-            new juce::AudioParameterFloat("post" + bandName, bandName + "Post Compression Gain", minpost, maxpost, defpost));
-        MBComp01AudioProcessor::addParameter(pre[band] =
-            new juce::AudioParameterFloat("pre" + bandName, bandName + "Pre Compression Gain", minpre, maxpre, defpre));
-
         iLvl[band] = 0;
         gLvl[band] = 0;
         oLvl[band] = 0;
+        wetCurve[band] = nullptr;
+        if (band < 3)
+            soloCurve[band] = nullptr;
     }
+    for (int i = 0; i < 8; i++)
+        fadeBuffer[i] = nullptr;
 
     MBComp01AudioProcessor::addParameter(f0 =
         new juce::AudioParameterFloat("splitf0", "Low", minf, maxf, deff0));
@@ -69,20 +108,59 @@ MBComp01AudioProcessor::MBComp01AudioProcessor()
         new juce::AudioParameterFloat("splitf1", "High", minf, maxf, deff1));
     MBComp01AudioProcessor::addParameter(la =
         new juce::AudioParameterFloat("la", "Lookahead", minla, maxla, defla));
+    MBComp01AudioProcessor::addParameter(tp =
+        new juce::AudioParameterBool("tp", "True Peak Limiter", deftp));
+    MBComp01AudioProcessor::addParameter(ceiling =
+        new juce::AudioParameterFloat("ceiling", "True Peak Ceiling", minceil, maxceil, defceil));
+    MBComp01AudioProcessor::addParameter(quality =
+        new juce::AudioParameterChoice("quality", "Quality", juce::StringArray{ "Eco", "Normal", "High" }, defquality));
+    MBComp01AudioProcessor::addParameter(multirate =
+        new juce::AudioParameterBool("multirate", "Multirate Detection", defmultirate));
+    MBComp01AudioProcessor::addParameter(mode =
+        new juce::AudioParameterChoice("mode", "Mode", juce::StringArray{ "Crossover", "Spectral" }, defmode));
+    MBComp01AudioProcessor::addParameter(bands =
+        new juce::AudioParameterInt("bands", "Spectral Bands", SPEC_MIN_BANDS, SPEC_MAX_BANDS, defbands));
+    MBComp01AudioProcessor::addParameter(slope =
+        new juce::AudioParameterChoice("slope", "Crossover Slope",
+            juce::StringArray{ "6 dB/oct", "LR 12 dB/oct", "LR 24 dB/oct", "LR 48 dB/oct" }, defslope));
+
+    // the core structs follow the plain values
+    for (int band = 0; band < 4; band++)
+    {
+        bind(at[band], &bandSettings[band].at);
+        bind(rt[band], &bandSettings[band].rt);
+        bind(la,       &bandSettings[band].la);
+        bind(CT[band], &bandSettings[band].CT);
+        bind(CR[band], &bandSettings[band].CR);
+    }
+    bind(f0, &splitSettings.f0);
+    bind(f1, &splitSettings.f1);
+    bind(slope, &splitSettings.slope);
+
+    // plain values of every parameter, then every change as an event
+    numParams = (int)getParameters().size();
+    plain = new float[numParams];
+    applied = new unsigned[numParams];
+    syncParameters();
+    for (auto* param : getParameters())
+        param->addListener(this);
+
+    limiter.setceiling(plainOf(ceiling));
+    limiter.setInterpolator(shared->getInterpolator());
 }
 MBComp01AudioProcessor::~MBComp01AudioProcessor()
 {
-    delete[] at;
-    delete[] rt;
-    delete[] CT;
-    delete[] CR;
-
-    delete[] pre;
-    delete[] post;
-
-    delete[] iLvl;
-    delete[] oLvl;
-    delete[] gLvl;
+    // the arena destroys the DSP objects, the presets still queued go here
+    Command command;
+    while (commands.pop(command))
+        delete command.preset;
+    delete pendingPreset;
+    freeRetired();
+    delete[] plain;
+    delete[] applied;
+    cancelPendingUpdate();
+    delete[] spectralReady.exchange(nullptr);
+    delete[] spectral;
 }
 //==============================================================================
 const juce::String MBComp01AudioProcessor::getName() const
@@ -115,7 +193,8 @@ bool MBComp01AudioProcessor::isMidiEffect() const
 }
 double MBComp01AudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    if (getSampleRate() <= 0) return 0.0;
+    return getTailSamples() / getSampleRate();
 }
 int MBComp01AudioProcessor::getNumPrograms()
 {
@@ -139,58 +218,117 @@ void MBComp01AudioProcessor::changeProgramName (int index, const juce::String& n
 //==============================================================================
 void MBComp01AudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
+    // the queues are drained, the parameters are read as they are now
+    applyEvents(std::numeric_limits<int>::max());
+    applyCommands();
+    finishFades();
+    syncParameters();
+
     // setting up fx modules
+    kernel = &kernels::get();
     int chnum = getTotalNumInputChannels();
-    filters = new Allpass * [chnum];
-    comps = new Compressor * [chnum];
+    int blockSize = juce::jmax(1, samplesPerBlock);
+    int maxDelay = (int)(maxla * sampleRate / 1000) + 1;
 
-    for (int ch = 0; ch < chnum; ch++)
+    // all DSP state in one block, reused when the new layout fits
+    arena.reserve(getArenaBytes(sampleRate, chnum, blockSize));
+    groupSize = groupSizeFor(chnum);
+    const int groups = chnum / groupSize;
+    filters = arena.create<Crossover>(groups);
+    comps = arena.create<Compressor*>(groups);
+    delays = arena.create<CircularBuffer<float>*>(chnum);
+    CircularBuffer<float>* delayBlock = arena.create<CircularBuffer<float>>(3 * chnum);
+    Compressor* compBlock = arena.create<Compressor>(4 * groups);
+
+    for (int group = 0; group < groups; group++)
     {
-        filters[ch] = new Allpass[2];
-        filters[ch][0].setfc(f0);
-        filters[ch][1].setfc(f1);
-        filters[ch][0].setfs(sampleRate);
-        filters[ch][1].setfs(sampleRate);
+        filters[group].setParameters(&splitSettings);
+        filters[group].setfs(sampleRate);
 
-        comps[ch] = new Compressor[4];
+        comps[group] = compBlock + 4 * group;
         for (int band = 0; band < 4; band++)
         {
-            comps[ch][band].setat(at[band]);
-            comps[ch][band].setrt(rt[band]);
-            comps[ch][band].setCT(CT[band]);
-            comps[ch][band].setCR(CR[band]);
-
-            //if (band == MAS)
-            comps[ch][band].setla(la);
-            //else
-            //    comps[ch][band].setla( nullptr );
-            comps[ch][band].setfs(sampleRate);
+            comps[group][band].setParameters(&bandSettings[band]);
+            comps[group][band].setfs(sampleRate, &arena);
+        }
+    }
+    for (int ch = 0; ch < chnum; ch++)
+    {
+        delays[ch] = delayBlock + 3 * ch;
+        for (int band = 0; band < 3; band++)
+        {
+            delays[ch][band].setStorage(arena.allocate<float>(maxDelay), maxDelay);
+            delays[ch][band].resize(comps[0][MAS].getLookahead());
         }
     }
 
+    // spectral state (~100 KB a channel) only when the mode needs it now,
+    // a later switch builds it off the audio thread
+    cancelPendingUpdate();
+    delete[] spectralReady.exchange(nullptr);
+    delete[] spectral;
+    spectral = nullptr;
+    spectralBytes = 0;
+    if (chnum > 0 && (int)valueOf(mode) == MODE_SPECTRAL)
+        spectral = createSpectral(sampleRate, chnum);
+    spectralActive = spectral != nullptr;
+
+    limiter.prepare(sampleRate, chnum, &arena);
+    setLatencySamples((chnum > 0 ? delays[0][0].getSize() : 0) + limiter.getLatency()
+        + (chnum > 0 && spectralActive ? spectral[0].getLatency() : 0));
+
     // setting up support buffer
-    supportBuffer = new float* [3];
-    supportBufferSize = 256;
-    for (int band = 0; band < 3; band++)
+    supportBuffer = arena.create<float*>(3 * groupSize);
+    sideBuffer = arena.create<float*>(4 * groupSize);
+    gainBuffer = arena.create<float*>(4);
+    supportBufferSize = blockSize;
+    for (int i = 0; i < 3 * groupSize; i++)
+        supportBuffer[i] = arena.allocate<float>(supportBufferSize);
+    for (int i = 0; i < 4 * groupSize; i++)
+        sideBuffer[i] = arena.allocate<float>(supportBufferSize);
+    for (int band = 0; band < 4; band++)
+        gainBuffer[band] = arena.allocate<float>(supportBufferSize);
+
+    // command crossfades
+    const int fadeLength = (int)(CMD_FADE_TIME * sampleRate / 1000);
+    for (int i = 0; i < 8; i++)
+        fadeBuffer[i] = arena.allocate<float>(supportBufferSize);
+    for (int band = 0; band < 4; band++)
     {
-        supportBuffer[band] = new float[supportBufferSize];
+        wetFade[band].setLength(fadeLength);
+        if (band < 3)
+            soloFade[band].setLength(fadeLength);
     }
+    outFade.setLength(fadeLength);
 }
-void MBComp01AudioProcessor::releaseResources()
+// Has to match the allocations of prepareToPlay, the arena throws on overflow.
+size_t MBComp01AudioProcessor::getArenaBytes(double sampleRate, int chnum, int blockSize) const
 {
-    int chnum = getTotalNumInputChannels();
+    const int maxDelay = (int)(maxla * sampleRate / 1000) + 1;
+    const int size = groupSizeFor(chnum), groups = chnum / size;
 
-    for (int ch = 0; ch < chnum; ch++)
-    {
-        delete[] filters[ch];
-        delete[] comps[ch];
-    }
-    for (int band = 0; band < 3; band++)
-        delete[] supportBuffer[band];
-
-    delete[] filters;
-    delete[] comps;
-    delete[] supportBuffer;
+    return Arena::bytes<Crossover>(groups) + Arena::bytes<Compressor*>(groups)
+        + Arena::bytes<CircularBuffer<float>*>(chnum)
+        + Arena::bytes<CircularBuffer<float>>(3 * chnum) + Arena::bytes<Compressor>(4 * groups)
+        + 4 * groups * Compressor::getArenaBytes(sampleRate)
+        + 3 * chnum * Arena::bytes<float>(maxDelay)
+        + TruePeakLimiter::getArenaBytes(sampleRate, chnum)
+        + Arena::bytes<float*>(3 * size) + Arena::bytes<float*>(4 * size) + Arena::bytes<float*>(4)
+        + (7 * size + 12) * Arena::bytes<float>(blockSize);
+}
+void MBComp01AudioProcessor::releaseResources()
+{
+    // the objects go, the arena keeps its memory for the next prepareToPlay
+    arena.clear();
+    filters = nullptr;
+    comps = nullptr;
+    delays = nullptr;
+    supportBuffer = nullptr;
+    sideBuffer = nullptr;
+    gainBuffer = nullptr;
+    for (int i = 0; i < 8; i++)
+        fadeBuffer[i] = nullptr;
+    supportBufferSize = 0;
 }
 #ifndef JucePlugin_PreferredChannelConfigurations
 bool MBComp01AudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
@@ -231,15 +369,102 @@ void MBComp01AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
         buffer.clear(i, 0, buffer.getNumSamples());
 
     //==========================================================================
-    // check and adjust supportBuffer size
-    if (supportBufferSize != bufferSize)
+    // parameters :: everything is read again if the queue was full, the
+    // events due at the start apply before the block level settings
+    if (eventsLost.exchange(false))
+        syncParameters();
+    applyEvents(0);
+    applyCommands();
+
+    //==========================================================================
+    // check and adjust lookahead, the audio is delayed once for all bands
+    // (in place, the delay lines hold the longest lookahead)
+    int lookahead = totalNumInputChannels > 0 ? comps[0][MAS].getLookahead() : 0;
+    if (totalNumInputChannels > 0 && lookahead != delays[0][0].getSize())
     {
-        for (int band = 0; band < 3; band++)
+        for (int channel = 0; channel < totalNumInputChannels; ++channel)
+            for (int band = 0; band < 3; band++)
+                delays[channel][band].resize(lookahead);
+    }
+
+    // mode :: the spectral path starts from a clean state, the band delays
+    // hold the spectral path's input (first) or stale bands, they restart too.
+    // The spectral state is built on first use: offline right here, live on
+    // the message thread while the crossover keeps playing
+    bool spectralMode = (int)valueOf(mode) == MODE_SPECTRAL && totalNumInputChannels > 0;
+    if (spectralMode && spectral == nullptr)
+    {
+        spectral = spectralReady.exchange(nullptr);
+        if (spectral == nullptr && isNonRealtime())
+            spectral = createSpectral(getSampleRate(), totalNumInputChannels);
+        else if (spectral == nullptr)
+            triggerAsyncUpdate();
+        spectralMode = spectral != nullptr;
+    }
+    if (spectralMode != spectralActive)
+    {
+        for (int channel = 0; channel < totalNumInputChannels; ++channel)
         {
-            delete[] supportBuffer[band];
-            supportBuffer[band] = new float[bufferSize];
+            if (spectralMode)
+                spectral[channel].reset();
+            else
+                for (int band = 0; band < 3; band++)
+                    delays[channel][band].clear();
         }
-        supportBufferSize = bufferSize;
+        spectralActive = spectralMode;
+    }
+
+    int latency = lookahead + limiter.getLatency()
+        + (totalNumInputChannels > 0 && spectralActive ? spectral[0].getLatency() : 0);
+    if (latency != getLatencySamples())
+        setLatencySamples(latency);
+
+    //==========================================================================
+    // idle :: once the input has been silent for the tail plus the settling
+    // of the envelopes every state is at rest, the DSP is skipped (and the
+    // state kept as it is) until the signal comes back. Not offline: the
+    // skip stops the periodic schedules (control rate, STFT hops), and a
+    // render has to land on the same grid wherever it started.
+    const int idleSamples = getIdleSamples();
+    if (!isNonRealtime() && isSilent(buffer, totalNumInputChannels, bufferSize))
+        silentSamples = juce::jmin(idleSamples, silentSamples + bufferSize);
+    else
+        silentSamples = 0;
+
+    if (silentSamples >= idleSamples)
+    {
+        for (int channel = 0; channel < totalNumInputChannels; ++channel)
+            buffer.clear(channel, 0, bufferSize);
+        for (int band = 0; band < 4; band++)
+        {
+            iLvl[band] = 0;
+            oLvl[band] = 0;
+            gLvl[band] = 1;
+        }
+        applyEvents(std::numeric_limits<int>::max());
+        applyCommands();
+        finishFades();
+        return;
+    }
+
+    //==========================================================================
+    // quality tier :: control rate of the gain computers
+    const auto& tier = qualityTiers[(int)valueOf(quality)];
+    const int groups = totalNumInputChannels / groupSize;
+    for (int group = 0; group < groups; ++group)
+        for (int band = 0; band < 4; band++)
+            comps[group][band].setInterval(tier.interval, tier.cubic);
+
+    //==========================================================================
+    // multirate :: the low and mid detectors run at a rate that follows
+    // their bandwidth, the audio bands stay at the host rate
+    bool decimate = valueOf(multirate) != 0;
+    int lowFactor = decimate ? decimationFor(getSampleRate(), valueOf(f0), lookahead) : 1;
+    int midFactor = decimate ? decimationFor(getSampleRate(), valueOf(f1), lookahead) : 1;
+    for (int group = 0; group < groups; ++group)
+    {
+        comps[group][LOW].setDecimation(lowFactor);
+        comps[group][MID].setDecimation(midFactor);
     }
 
     //==========================================================================
@@ -252,92 +477,37 @@ void MBComp01AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
     }
 
     //==========================================================================
-    // process audio
-    for (int channel = 0; channel < totalNumInputChannels; ++channel)
+    // process audio in pieces: split at every parameter event, at the
+    // prepared block size and where a preset swap reaches silence (block
+    // level settings follow at the next block)
+    int pieces = 0;
+    for (int start = 0; start < bufferSize; pieces++)
     {
-        float* channelData = buffer.getWritePointer(channel);
-        for (int i = 0; i < bufferSize; i++)
-        {
-            supportBuffer[LOW][i] = channelData[i];
-            supportBuffer[MID][i] = channelData[i];
-            // the high band will be filtered from the mid band, not the input
-        }
-
-        //======================================================================
-        // wire up fx modules to main buffer
-        // filters
-        filters[channel][0].setIn(channelData);
-        filters[channel][1].setIn(supportBuffer[MID]);
+        applyEvents(start);
+        applyCommands();
+        if (pendingPreset != nullptr && !outFade.isFading())
+            applyPreset();
 
-        filters[channel][0].setOut(supportBuffer[LOW]);
-        filters[channel][0].setNeg(supportBuffer[MID]);
-        filters[channel][1].setOut(supportBuffer[MID]);
-        filters[channel][1].setNeg(supportBuffer[HHI]);
+        int end = juce::jmin(bufferSize, start + supportBufferSize);
+        if (const ParameterEvent* next = events.front())
+            end = juce::jmin(end, next->offset);
+        if (pendingPreset != nullptr)
+            end = juce::jmin(end, start + outFade.getRemaining());
 
-        // compressors
-        for (int band = 0; band < 3; band++)
-        {
-            comps[channel][band].setInputBuffer(supportBuffer[band]);
-            comps[channel][band].setOutputBuffer(supportBuffer[band]);
-        }
-        comps[channel][MAS].setInputBuffer(channelData);
-        comps[channel][MAS].setOutputBuffer(channelData);
-
-        //======================================================================
-        // Filtering
-        filters[channel][0].process(bufferSize);
-        for (int i = 0; i < bufferSize; i++)
-        {
-            supportBuffer[LOW][i] /= 2;
-            supportBuffer[HHI][i] = (supportBuffer[MID][i] /= 2);
-        }
-        filters[channel][1].process(bufferSize);
-        for (int i = 0; i < bufferSize; i++)
-        {
-            supportBuffer[MID][i] /= 2;
-            supportBuffer[HHI][i] /= 2;
-        }
-
-        //======================================================================
-        // Compression
-        for (int band = 0; band < 3; band++)
-        {
-            for (int i = 0; i < bufferSize; i++)
-                supportBuffer[band][i] *= pow(10, *pre[band] / 20);
-            iLvl[band] = calculateRMS(supportBuffer[band], bufferSize);
-            comps[channel][band].process(bufferSize);
-            oLvl[band] = calculateRMS(supportBuffer[band], bufferSize); // EXCLUING POST
-            gLvl[band] = comps[channel][band].getGRMS();
-        }
-
-        //======================================================================
-        // Addition for output (Mixing)
-        for (int i = 0; i < bufferSize; i++)
-        {
-            channelData[i] = 0;
-            for (int band = 0; band < 3; band++)
-                if(solo == MAS || solo == band) 
-                    channelData[i] += supportBuffer[band][i] * pow(10, *post[band] / 20);
-        }
-
-        //======================================================================
-        // Master compression
-        buffer.applyGain( pow(10, *pre[MAS]/20) );
-        iLvl[MAS] += buffer.getRMSLevel(channel, 0, bufferSize);
-        comps[channel][MAS].process(bufferSize);
-        buffer.applyGain( pow(10, *post[MAS]/20) );
-
-        // summing for display
-        oLvl[MAS] += buffer.getRMSLevel(channel, 0, bufferSize);
-        gLvl[MAS] += comps[channel][MAS].getGRMS();
+        renderFades(end - start);
+        juce::AudioBuffer<float> piece(buffer.getArrayOfWritePointers(), totalNumInputChannels, start, end - start);
+        processChannels(piece, end - start);
+        start = end;
     }
+    applyEvents(std::numeric_limits<int>::max());
 
     // calcuating levels
+    int count = juce::jmax(1, totalNumInputChannels * pieces);
     for (int band = 0; band < 4; band++)
     {
-        iLvl[band] /= totalNumInputChannels;
-        oLvl[band] /= totalNumInputChannels;
-        gLvl[band] /= totalNumInputChannels;
+        iLvl[band] /= count;
+        oLvl[band] /= count;
+        gLvl[band] /= count;
     }
 }
 //==============================================================================
@@ -355,29 +525,21 @@ void MBComp01AudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
     std::unique_ptr<juce::XmlElement> xml(new juce::XmlElement("MBComp"));
 
-    std::string bandName;
+    juce::AudioParameterFloat** const slots[NUM_BAND_PARAMETERS] = { at, rt, CT, CR, post, pre };
     for (int band = 0; band < 4; band++)
-    {
-        switch (band)
-        {
-        case 0: bandName = "Low"; break;
-        case 1: bandName = "Mid"; break;
-        case 2: bandName = "High"; break;
-        case 3: bandName = "Master"; break;
-        default: bandName = "ERROR";
-        }
-
-        xml->setAttribute(juce::String("at"+bandName), (double)*at[band]);
-        xml->setAttribute(juce::String("rt"+bandName), (double)*rt[band]);
-        xml->setAttribute(juce::String("CT"+bandName), (double)*CT[band]);
-        xml->setAttribute(juce::String("CR"+bandName), (double)*CR[band]);
-        xml->setAttribute(juce::String("pre" +bandName), (double)*pre [band]);
-        xml->setAttribute(juce::String("post"+bandName), (double)*post[band]);
-    }
+        for (int k = 0; k < NUM_BAND_PARAMETERS; k++)
+            xml->setAttribute(bandParameters[k].id[band], (double)*slots[k][band]);
 
     xml->setAttribute("la", (double)*la);
     xml->setAttribute("f0", (double)*f0);
     xml->setAttribute("f1", (double)*f1);
+    xml->setAttribute("tp", (bool)*tp);
+    xml->setAttribute("ceiling", (double)*ceiling);
+    xml->setAttribute("quality", quality->getIndex());
+    xml->setAttribute("multirate", (bool)*multirate);
+    xml->setAttribute("mode", mode->getIndex());
+    xml->setAttribute("bands", (int)*bands);
+    xml->setAttribute("slope", slope->getIndex());
     copyXmlToBinary(*xml, destData);
 }
 void MBComp01AudioProcessor::setStateInformation (const void* data, int sizeInBytes)
@@ -390,30 +552,39 @@ void MBComp01AudioProcessor::setStateInformation (const void* data, int sizeInBy
     {
         if (xmlState->hasTagName("MBComp"))
         {
-            std::string bandName;
-            for (int band = 0; band < 4; band++)
+            // collected first, then swapped in as a whole (crossfaded)
+            float* values = new float[numParams];
+            for (int i = 0; i < numParams; i++)
             {
-                switch (band)
+                auto* param = static_cast<juce::RangedAudioParameter*>(getParameters()[i]);
+                values[i] = param->convertFrom0to1(param->getValue());
+            }
+            auto set = [this, values](const juce::AudioProcessorParameter* param, double value)
                 {
-                case 0: bandName = "Low"; break;
-                case 1: bandName = "Mid"; break;
-                case 2: bandName = "High"; break;
-                case 3: bandName = "Master"; break;
-                default: bandName = "ERROR";
-                }
+                    values[param->getParameterIndex()] = (float)value;
+                };
 
-                *at[band] = (float)xmlState->getDoubleAttribute(juce::String("at"+bandName), defat);
-                *rt[band] = (float)xmlState->getDoubleAttribute(juce::String("rt"+bandName), defrt);
-                *CT[band] = (float)xmlState->getDoubleAttribute(juce::String("CT"+bandName), defCT);
-                *CR[band] = (float)xmlState->getDoubleAttribute(juce::String("CR"+bandName), defCR);
+            juce::AudioParameterFloat** const slots[NUM_BAND_PARAMETERS] = { at, rt, CT, CR, post, pre };
+            for (int band = 0; band < 4; band++)
+                for (int k = 0; k < NUM_BAND_PARAMETERS; k++)
+                {
+                    const auto& row = bandParameters[k];
+                    set(slots[k][band], xmlState->getDoubleAttribute(row.id[band], row.def));
+                }
 
-                *pre[band] = (float)xmlState->getDoubleAttribute(juce::String("pre"+bandName), defpre);
-                *post[band] = (float)xmlState->getDoubleAttribute(juce::String("post"+bandName), defpost);
-            }
+            set(la, xmlState->getDoubleAttribute("la", defla));
+            set(f0, xmlState->getDoubleAttribute("f0", deff0));
+            set(f1, xmlState->getDoubleAttribute("f1", deff1));
+            set(tp, xmlState->getBoolAttribute("tp", deftp) ? 1 : 0);
+            set(ceiling, xmlState->getDoubleAttribute("ceiling", defceil));
+            set(quality, xmlState->getIntAttribute("quality", defquality));
+            set(multirate, xmlState->getBoolAttribute("multirate", defmultirate) ? 1 : 0);
+            set(mode, xmlState->getIntAttribute("mode", defmode));
+            set(bands, xmlState->getIntAttribute("bands", defbands));
+            set(slope, xmlState->getIntAttribute("slope", SLOPE_6));
 
-            *la = (float)xmlState->getDoubleAttribute("la", defla);
-            *f0 = (float)xmlState->getDoubleAttribute("f0", deff0);
-            *f1 = (float)xmlState->getDoubleAttribute("f1", deff1);
+            swapPreset(values);
+            delete[] values;
         }
     }
 }
@@ -468,19 +639,521 @@ juce::AudioParameterFloat* MBComp01AudioProcessor::getf1()
 {
     return f1;
 }
+juce::AudioParameterBool* MBComp01AudioProcessor::gettp()
+{
+    return tp;
+}
+juce::AudioParameterFloat* MBComp01AudioProcessor::getceiling()
+{
+    return ceiling;
+}
+juce::AudioParameterChoice* MBComp01AudioProcessor::getquality()
+{
+    return quality;
+}
+juce::AudioParameterBool* MBComp01AudioProcessor::getmultirate()
+{
+    return multirate;
+}
+juce::AudioParameterChoice* MBComp01AudioProcessor::getmode()
+{
+    return mode;
+}
+juce::AudioParameterInt* MBComp01AudioProcessor::getbands()
+{
+    return bands;
+}
+juce::AudioParameterChoice* MBComp01AudioProcessor::getslope()
+{
+    return slope;
+}
 
+void MBComp01AudioProcessor::postParameterChange(int index, float plainValue, int sampleOffset)
+{
+    if (!events.push({ index, plainValue, juce::jmax(0, sampleOffset) }))
+        eventsLost = true;
+}
 void MBComp01AudioProcessor::setSolo(int soloBand)
 {
-    solo = soloBand;
+    pushCommand({ CMD_SOLO, soloBand, 0, nullptr });
+}
+void MBComp01AudioProcessor::setBypass(int band, bool bypassed)
+{
+    pushCommand({ CMD_BYPASS, band, bypassed ? 1.0f : 0.0f, nullptr });
+}
+void MBComp01AudioProcessor::subscribeMeters(bool subscribe)
+{
+    pushCommand({ CMD_METERS, MAS, subscribe ? 1.0f : -1.0f, nullptr });
+}
+void MBComp01AudioProcessor::swapPreset(const float* plainValues)
+{
+    freeRetired();
+    Preset* preset = new Preset(numParams);
+    std::copy(plainValues, plainValues + numParams, preset->plain);
+
+    // the parameters take the new values without queuing events, the audio
+    // thread switches over at the bottom of the fade (other threads keep
+    // queuing theirs, the ones after this write win)
+    presetWriter = this;
+    for (int i = 0; i < numParams; i++)
+    {
+        auto* param = static_cast<juce::RangedAudioParameter*>(getParameters()[i]);
+        preset->since[i] = events.getWriteCount();
+        param->setValueNotifyingHost(param->convertTo0to1(preset->plain[i]));
+    }
+    presetWriter = nullptr;
+
+    // no room: switch over without the fade
+    if (!pushCommand({ CMD_PRESET, MAS, 0, preset }))
+    {
+        delete preset;
+        eventsLost = true;
+    }
+}
+juce::String MBComp01AudioProcessor::getKernelName() const
+{
+    return kernel->name;
+}
+size_t MBComp01AudioProcessor::getMemoryFootprint() const
+{
+    return sizeof(*this) + arena.getCapacity() + spectralBytes;
+}
+SharedContext& MBComp01AudioProcessor::getSharedContext()
+{
+    return *shared;
 }
 //==============================================================================
-float MBComp01AudioProcessor::calculateRMS(float* buffer, int bufferSize) const
+void MBComp01AudioProcessor::processChannels(juce::AudioBuffer<float>& buffer, int bufferSize)
 {
-    float rms = 0;
-    for (int i = 0; i < bufferSize; i++)
+    const int numChannels = buffer.getNumChannels();
+    const bool metering = meterSubscribers > 0;
+
+    // a stereo pair goes through as one group, every stage sees both
+    for (int first = 0; first + groupSize <= numChannels; first += groupSize)
     {
-        rms += (buffer[i] * buffer[i]);
+        const int group = first / groupSize;
+        float* data[2] = { buffer.getWritePointer(first), buffer.getWritePointer(first + groupSize - 1) };
+
+        if (spectralActive)
+            for (int c = 0; c < groupSize; c++)
+                processSpectral(first + c, data[c], bufferSize);
+        else
+            processBands(group, data, bufferSize);
+
+        //======================================================================
+        // Master compression
+        for (int c = 0; c < groupSize; c++)
+        {
+            float* side = sideBuffer[4 * c + MAS];
+            if (preGain[MAS] != 1)
+            {
+                kernel->scale(data[c], preGain[MAS], bufferSize);
+                kernel->scale(side, preGain[MAS], bufferSize);
+            }
+            if (metering)
+                iLvl[MAS] += calculateRMS(data[c], bufferSize);
+        }
+
+        Compressor& master = comps[group][MAS];
+        bool bypassed = master.updateBypass();
+        if (!bypassed)
+        {
+            master.setInputBuffer(sideBuffer[MAS], groupSize == 2 ? sideBuffer[4 + MAS] : nullptr);
+            master.setGainBuffer(gainBuffer[MAS]);
+            master.process(bufferSize);
+            bypassed = !blendWet(MAS, gainBuffer[MAS], bufferSize);
+        }
+        for (int c = 0; c < groupSize; c++)
+        {
+            if (!bypassed)
+                kernel->applyGain(data[c], gainBuffer[MAS], postGain[MAS], bufferSize);
+            else if (postGain[MAS] != 1)
+                kernel->scale(data[c], postGain[MAS], bufferSize);
+
+            // summing for display
+            if (metering)
+            {
+                oLvl[MAS] += calculateRMS(data[c], bufferSize);
+                gLvl[MAS] += master.getGRMS();
+            }
+        }
+    }
+
+    //==========================================================================
+    // True peak limiting (all channels at once, the gain is linked)
+    limiter.process(buffer.getArrayOfWritePointers(), bufferSize, valueOf(tp) != 0);
+
+    // preset swap dip
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        if (outCurve != nullptr)
+            kernel->applyGain(buffer.getWritePointer(channel), outCurve, 1.0f, bufferSize);
+        else if (outFade.getValue() != 1)
+            kernel->scale(buffer.getWritePointer(channel), outFade.getValue(), bufferSize);
+    }
+}
+//==============================================================================
+// Crossover and band compressors of a channel group. Leaves the delayed band
+// mix in data[] and the undelayed mix (for the master detector) in the
+// group's sideBuffer[MAS].
+void MBComp01AudioProcessor::processBands(int group, float* const* data, int bufferSize)
+{
+    const int first = group * groupSize;
+    float** side[2] = { sideBuffer, sideBuffer + 4 * (groupSize - 1) };
+    float** support[2] = { supportBuffer, supportBuffer + 3 * (groupSize - 1) };
+
+    //==========================================================================
+    // Filtering
+    // one split of the undelayed input: the detectors run on its bands, the
+    // audio bands are the same bands out of the lookahead delay
+    if (groupSize == 2)
+        filters[group].process(data, side, bufferSize);
+    else
+        filters[group].process(data[0], side[0], bufferSize);
+    for (int c = 0; c < groupSize; c++)
+        for (int band = 0; band < 3; band++)
+            delays[first + c][band].push(side[c][band], support[c][band], bufferSize);
+
+    //==========================================================================
+    // Compression
+    // no-op bands (ratio 1) skip the compressor, 0 dB skips the gain,
+    // bypassed bands keep their envelope running but pass at unity
+    const bool metering = meterSubscribers > 0;
+    bool bypassed[3];
+    for (int band = 0; band < 3; band++)
+    {
+        for (int c = 0; c < groupSize; c++)
+        {
+            if (preGain[band] != 1)
+            {
+                kernel->scale(side[c][band], preGain[band], bufferSize);
+                kernel->scale(support[c][band], preGain[band], bufferSize);
+            }
+            if (metering)
+                iLvl[band] += calculateRMS(support[c][band], bufferSize);
+        }
+
+        Compressor& comp = comps[group][band];
+        bypassed[band] = comp.updateBypass();
+        if (!bypassed[band])
+        {
+            comp.setInputBuffer(side[0][band], groupSize == 2 ? side[1][band] : nullptr);
+            comp.setGainBuffer(gainBuffer[band]);
+            comp.process(bufferSize);
+            bypassed[band] = !blendWet(band, gainBuffer[band], bufferSize);
+        }
+        for (int c = 0; c < groupSize; c++)
+        {
+            if (!bypassed[band])
+                kernel->applyGain(support[c][band], gainBuffer[band], 1.0f, bufferSize);
+
+            if (metering)
+            {
+                oLvl[band] += calculateRMS(support[c][band], bufferSize); // EXCLUING POST
+                gLvl[band] += comp.getGRMS();
+            }
+        }
+    }
+
+    //==========================================================================
+    // Addition for output (Mixing)
+    // the master detector gets the same mix from the undelayed bands. The
+    // band gains are timed for the delayed audio, on the undelayed bands a
+    // gain dip lags its transient by the lookahead: the master sees band
+    // transients with less of their reduction than the audio will have and
+    // clamps them a little harder. Timing them right would need the band
+    // gains a lookahead earlier, another lookahead of latency.
+    for (int c = 0; c < groupSize; c++)
+        for (int i = 0; i < bufferSize; i++)
+        {
+            data[c][i] = 0;
+            side[c][MAS][i] = 0;
+        }
+    // solo fades the other bands out of both mixes
+    for (int band = 0; band < 3; band++)
+    {
+        const float* curve = soloCurve[band];
+        if (curve == nullptr && soloFade[band].getValue() == 0)
+            continue;
+
+        if (curve == nullptr)
+        {
+            for (int c = 0; c < groupSize; c++)
+            {
+                kernel->mix(data[c], support[c][band], postGain[band], bufferSize);
+                if (bypassed[band])
+                    kernel->mix(side[c][MAS], side[c][band], postGain[band], bufferSize);
+                else
+                    kernel->mixGain(side[c][MAS], side[c][band], gainBuffer[band], postGain[band], bufferSize);
+            }
+        }
+        else
+        {
+            for (int c = 0; c < groupSize; c++)
+                kernel->mixGain(data[c], support[c][band], curve, postGain[band], bufferSize);
+            if (!bypassed[band])
+            {
+                kernel->applyGain(gainBuffer[band], curve, 1.0f, bufferSize);
+                curve = gainBuffer[band];
+            }
+            for (int c = 0; c < groupSize; c++)
+                kernel->mixGain(side[c][MAS], side[c][band], curve, postGain[band], bufferSize);
+        }
+    }
+}
+// Spectral band dynamics. Same outputs as processBands().
+void MBComp01AudioProcessor::processSpectral(int channel, float* channelData, int bufferSize)
+{
+    spectral[channel].process(channelData, bufferSize);
+    std::copy(channelData, channelData + bufferSize, sideBuffer[4 * (channel % groupSize) + MAS]);
+    delays[channel][0].push(channelData, channelData, bufferSize);
+
+    if (meterSubscribers > 0)
+        for (int band = 0; band < 3; band++)
+        {
+            iLvl[band] += spectral[channel].getRegionInput(band);
+            oLvl[band] += spectral[channel].getRegionOutput(band);
+            gLvl[band] += spectral[channel].getRegionGain(band);
+        }
+}
+// Outside the arena: instances that never use the spectral mode don't pay
+// for its FFT frames.
+SpectralCompressor* MBComp01AudioProcessor::createSpectral(double sampleRate, int chnum)
+{
+    SpectralCompressor* block = new SpectralCompressor[chnum];
+    const int order = SpectralCompressor::orderFor(sampleRate);
+    for (int ch = 0; ch < chnum; ch++)
+    {
+        for (int band = 0; band < 3; band++)
+            block[ch].setBandParameters(band, plainOf(at[band]), plainOf(rt[band]), plainOf(CT[band]),
+                                        plainOf(CR[band]), plainOf(pre[band]), plainOf(post[band]));
+        block[ch].setf0(plainOf(f0));
+        block[ch].setf1(plainOf(f1));
+        block[ch].setbands(plainOf(bands));
+        block[ch].prepare(sampleRate, shared->getFFT(order), shared->getWindow(order));
+    }
+    spectralBytes = chnum * sizeof(SpectralCompressor);
+    return block;
+}
+void MBComp01AudioProcessor::handleAsyncUpdate()
+{
+    // one block per prepareToPlay, the audio thread takes it at the next block
+    const int chnum = getTotalNumInputChannels();
+    if (spectralBytes != 0 || chnum == 0 || getSampleRate() <= 0)
+        return;
+    spectralReady = createSpectral(getSampleRate(), chnum);
+}
+//==============================================================================
+// Host automation and GUI edits, any thread.
+void MBComp01AudioProcessor::parameterValueChanged(int parameterIndex, float newValue)
+{
+    if (presetWriter == this) return;
+    auto* param = static_cast<juce::RangedAudioParameter*>(getParameters()[parameterIndex]);
+    postParameterChange(parameterIndex, param->convertFrom0to1(newValue));
+}
+void MBComp01AudioProcessor::parameterGestureChanged(int parameterIndex, bool gestureIsStarting)
+{
+}
+// plain <- the parameters as they are now, bypassing the queue. The values
+// are at least as new as every event queued before they are read (a
+// parameter is written before its event is queued), those events are stale.
+void MBComp01AudioProcessor::syncParameters()
+{
+    const unsigned queued = events.getWriteCount();
+    for (int i = 0; i < numParams; i++)
+    {
+        auto* param = static_cast<juce::RangedAudioParameter*>(getParameters()[i]);
+        applyParameter(i, param->convertFrom0to1(param->getValue()));
+        applied[i] = queued - 1;
+    }
+}
+// Only what depends on the changed parameter is updated here, the
+// processors recompute their own coefficients when they see a new value.
+void MBComp01AudioProcessor::applyParameter(int index, float value)
+{
+    if (index < 0 || index >= numParams) return;
+    plain[index] = value;
+    for (int b = 0; b < numBindings; b++)
+        if (bindings[b].index == index)
+            *bindings[b].field = value;
+
+    // linear gains, 0 dB is exactly 1 so the gain passes can be skipped
+    for (int band = 0; band < 4; band++)
+    {
+        if (index == pre[band]->getParameterIndex())
+            preGain[band] = value == 0 ? 1.0f : fastmath::fast_db_to_gain(value);
+        else if (index == post[band]->getParameterIndex())
+            postGain[band] = value == 0 ? 1.0f : fastmath::fast_db_to_gain(value);
+    }
+}
+void MBComp01AudioProcessor::bind(const juce::AudioProcessorParameter* param, float* field)
+{
+    jassert(numBindings < NUM_BINDINGS);
+    bindings[numBindings++] = { param->getParameterIndex(), field };
+}
+// The queued events due at or before `offset`. Events queued before the
+// value a parameter already has (a resync after an overflow, a preset) are
+// stale and dropped.
+void MBComp01AudioProcessor::applyEvents(int offset)
+{
+    ParameterEvent event;
+    for (const ParameterEvent* next = events.front(); next != nullptr && next->offset <= offset; next = events.front())
+    {
+        const unsigned position = events.getReadCount();
+        events.pop(event);
+        if (event.index < 0 || event.index >= numParams || (int)(position - applied[event.index]) <= 0)
+            continue;
+        applyParameter(event.index, event.value);
+        applied[event.index] = position;
+    }
+}
+//==============================================================================
+bool MBComp01AudioProcessor::pushCommand(const Command& command)
+{
+    return commands.push(command);
+}
+// The queued commands, audio thread. Fades only get a new target here, they
+// advance with the pieces (renderFades).
+void MBComp01AudioProcessor::applyCommands()
+{
+    Command command;
+    while (commands.pop(command))
+    {
+        switch (command.type)
+        {
+        case CMD_SOLO:
+            solo = command.band;
+            for (int band = 0; band < 3; band++)
+                soloFade[band].setTarget(solo == MAS || solo == band ? 1.0f : 0.0f);
+            break;
+        case CMD_BYPASS:
+            if (command.band >= 0 && command.band < 4)
+                wetFade[command.band].setTarget(command.value != 0 ? 0.0f : 1.0f);
+            break;
+        case CMD_METERS:
+            meterSubscribers = juce::jmax(0, meterSubscribers + (int)command.value);
+            break;
+        case CMD_PRESET:
+            // a newer preset replaces the one still fading out
+            if (pendingPreset != nullptr)
+                retirePreset(pendingPreset);
+            pendingPreset = command.preset;
+            outFade.setTarget(0);
+            break;
+        default:
+            break;
+        }
+    }
+}
+// The output is silent: every parameter switches over, then fades back in.
+// A parameter whose last applied event was queued after the preset wrote it
+// keeps that newer value; events still queued apply after the preset anyway.
+void MBComp01AudioProcessor::applyPreset()
+{
+    for (int i = 0; i < numParams; i++)
+    {
+        if ((int)(applied[i] - pendingPreset->since[i]) < 0)
+        {
+            applyParameter(i, pendingPreset->plain[i]);
+            applied[i] = pendingPreset->since[i] - 1;
+        }
     }
+    retirePreset(pendingPreset);
+    pendingPreset = nullptr;
+    outFade.setTarget(1);
+}
+// Preset blocks are freed by the producers (freeRetired), never here. The
+// ring holds every block the command queue can, a full one leaks the block.
+// Each block is popped by exactly one producer, no lock around the delete.
+void MBComp01AudioProcessor::retirePreset(Preset* preset)
+{
+    bool stored = retired.push(preset);
+    jassert(stored);
+    juce::ignoreUnused(stored);
+}
+void MBComp01AudioProcessor::freeRetired()
+{
+    Preset* preset;
+    while (retired.pop(preset))
+        delete preset;
+}
+// ramps of the next piece, shared by all channels
+void MBComp01AudioProcessor::renderFades(int bufferSize)
+{
+    for (int band = 0; band < 4; band++)
+    {
+        wetCurve[band] = wetFade[band].render(fadeBuffer[3 + band], bufferSize) ? fadeBuffer[3 + band] : nullptr;
+        if (band < 3)
+            soloCurve[band] = soloFade[band].render(fadeBuffer[band], bufferSize) ? fadeBuffer[band] : nullptr;
+    }
+    outCurve = outFade.render(fadeBuffer[7], bufferSize) ? fadeBuffer[7] : nullptr;
+}
+// no audio to fade (idle, re-prepare): every fade is at its target at once
+void MBComp01AudioProcessor::finishFades()
+{
+    for (int band = 0; band < 4; band++)
+    {
+        wetFade[band].jump(wetFade[band].getTarget());
+        if (band < 3)
+            soloFade[band].jump(soloFade[band].getTarget());
+    }
+    if (pendingPreset != nullptr)
+        applyPreset();
+    outFade.jump(1);
+}
+// Band bypass: the gain curve moves towards unity with the wet fade. False
+// when the band is fully bypassed and the gain can be skipped.
+bool MBComp01AudioProcessor::blendWet(int band, float* gain, int bufferSize) const
+{
+    if (const float* wet = wetCurve[band])
+    {
+        for (int i = 0; i < bufferSize; i++)
+            gain[i] = 1 + wet[i] * (gain[i] - 1);
+        return true;
+    }
+    return wetFade[band].getValue() != 0;
+}
+const float* MBComp01AudioProcessor::plainOf(const juce::AudioProcessorParameter* param) const
+{
+    return plain + param->getParameterIndex();
+}
+float MBComp01AudioProcessor::valueOf(const juce::AudioProcessorParameter* param) const
+{
+    return plain[param->getParameterIndex()];
+}
+bool MBComp01AudioProcessor::isSilent(juce::AudioBuffer<float>& buffer, int numChannels, int bufferSize) const
+{
+    for (int channel = 0; channel < numChannels; ++channel)
+        if (buffer.getMagnitude(channel, 0, bufferSize) > IDLE_LEVEL)
+            return false;
+    return true;
+}
+// the delay lines plus the ringing of the audio crossover
+int MBComp01AudioProcessor::getTailSamples() const
+{
+    int ring = filters != nullptr && getTotalNumInputChannels() > 0 && !spectralActive
+        ? filters[0].getTailSamples() : 0;
+    return getLatencySamples() + ring;
+}
+// tail plus IDLE_SETTLE time constants of the slowest envelope: the RMS
+// detector or the gain release of any band
+int MBComp01AudioProcessor::getIdleSamples() const
+{
+    float release = RMS_R_TIME;     // [ms]
+    for (int band = 0; band < 4; band++)
+        release = juce::jmax(release, valueOf(rt[band]) / 2.2f);
+    return getTailSamples() + (int)(IDLE_SETTLE * release * getSampleRate() / 1000);
+}
+int MBComp01AudioProcessor::getSettleSamples() const
+{
+    float slowest = RMS_R_TIME;     // [ms]
+    for (int band = 0; band < 4; band++)
+        slowest = juce::jmax(slowest, valueOf(at[band]) / 2.2f, valueOf(rt[band]) / 2.2f);
+    return getTailSamples() + (int)(IDLE_SETTLE * slowest * getSampleRate() / 1000);
+}
+float MBComp01AudioProcessor::calculateRMS(float* buffer, int bufferSize) const
+{
+    float rms = kernel->sumSquares(buffer, bufferSize);
     rms /= (float)bufferSize;
     return sqrt(rms);
 }
@@ -11,8 +11,60 @@
 #include <juce_core/juce_core.h>
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <juce_audio_processors/juce_audio_processors.h>
-#include "processors/Compressor.h"
-#include "processors/Allpass.h"
+#include "core/Compressor.h"
+#include "core/Crossover.h"
+#include "processors/TruePeakLimiter.h"
+#include "processors/SpectralCompressor.h"
+#include "core/Fade.h"
+#include "processors/SharedContext.h"
+#include "containers/Arena.h"
+#include "containers/EventQueue.h"
+#include "kernels/Kernels.h"
+
+#define PARAM_QUEUE_SIZE    1024    // parameter events between two blocks
+#define NUM_BINDINGS        (4 * 5 + 3) // parameters the DSP core reads, see bind()
+#define CMD_QUEUE_SIZE      256     // GUI commands between two blocks
+#define CMD_FADE_TIME       10      // [ms] solo, bypass and preset crossfades
+
+// command types
+#define CMD_SOLO            0
+#define CMD_BYPASS          1
+#define CMD_METERS          2
+#define CMD_PRESET          3
+
+// Plain value of a parameter, due `offset` samples into the next block.
+struct ParameterEvent {
+    int index;
+    float value;
+    int offset;
+};
+
+// Values of a swapPreset() call, by parameter index, and the event queue
+// position at which each parameter took its value: events queued from there
+// on are newer than the preset.
+struct Preset {
+    Preset(int numParams) : plain(new float[numParams]), since(new unsigned[numParams])
+    {
+    }
+    ~Preset()
+    {
+        delete[] plain;
+        delete[] since;
+    }
+    Preset(const Preset&) = delete;
+    Preset& operator=(const Preset&) = delete;
+
+    float* plain;
+    unsigned* since;
+};
+
+// GUI action for the audio thread, applied at the next block or piece.
+struct Command {
+    int type;
+    int band;       // CMD_SOLO (MAS: none), CMD_BYPASS
+    float value;    // CMD_BYPASS: 1 bypassed, CMD_METERS: +1 / -1 subscriber
+    Preset* preset; // CMD_PRESET, owned by the queue
+};
 
 //==============================================================================
 /**
@@ -21,6 +73,8 @@ class MBComp01AudioProcessor  : public juce::AudioProcessor
                             #if JucePlugin_Enable_ARA
                              , public juce::AudioProcessorARAExtension
                             #endif
+                             , private juce::AudioProcessorParameter::Listener
+                             , private juce::AsyncUpdater
 {
 public:
     //==============================================================================
@@ -68,37 +122,164 @@ public:
     juce::AudioParameterFloat* getla();
     juce::AudioParameterFloat* getf0();
     juce::AudioParameterFloat* getf1();
+    juce::AudioParameterBool*  gettp();
+    juce::AudioParameterFloat* getceiling();
+    juce::AudioParameterChoice* getquality();
+    juce::AudioParameterBool*  getmultirate();
+    juce::AudioParameterChoice* getmode();
+    juce::AudioParameterInt*   getbands();
+    juce::AudioParameterChoice* getslope();
+
+    // Queues a plain value for the parameter with `index`, due
+    // `sampleOffset` samples into the next block (past its end: at its end).
+    // Host automation and GUI edits come through here as well, at offset 0.
+    void postParameterChange(int index, float plainValue, int sampleOffset = 0);
 
+    // Commands :: any thread, the audio thread takes them at the next block
+    // or piece boundary without waiting. Solo, bypass and presets crossfade
+    // over CMD_FADE_TIME. Solo and band bypass act on the crossover bands,
+    // MAS bypasses the master compressor in both modes.
     void setSolo(int soloBand);
+    void setBypass(int band, bool bypassed);
+    // level meters are only computed while someone is subscribed
+    void subscribeMeters(bool subscribe);
+    // plain values of every parameter, by index: the parameters take them
+    // at once, the audio fades out, switches over and fades back in; events
+    // queued after a parameter took the preset value win over it
+    void swapPreset(const float* plainValues);
+    // instruction set of the DSP kernels in use (diagnostics)
+    juce::String getKernelName() const;
+    // bytes held by this instance: the object, its DSP arena and the spectral
+    // state when built (the JUCE parameters and the SharedContext not included)
+    size_t getMemoryFootprint() const;
+    // tables and worker threads shared by all instances of the process
+    SharedContext& getSharedContext();
+    // Samples after which the output no longer depends on the state the
+    // DSP started from (to about IDLE_LEVEL): the tail plus IDLE_SETTLE time
+    // constants of the slowest envelope, attack or release. Valid after
+    // prepareToPlay, offline renders warm a fresh instance up this long.
+    int getSettleSamples() const;
 
 private:
     //==============================================================================
+    // parameters :: every change goes through the event queue into plain,
+    // the DSP reads plain only (no atomics in the sample loops)
+    void parameterValueChanged(int parameterIndex, float newValue) override;
+    void parameterGestureChanged(int parameterIndex, bool gestureIsStarting) override;
+    void syncParameters();
+    void applyParameter(int index, float value);
+    void applyEvents(int offset);
+    // `field` of the core parameter structs follows the plain value of `param`
+    void bind(const juce::AudioProcessorParameter* param, float* field);
+    // commands :: wait-free on the audio side, the preset blocks go back
+    // through `retired` to be freed by the producers
+    bool pushCommand(const Command& command);
+    void applyCommands();
+    void applyPreset();
+    void retirePreset(Preset* preset);
+    void freeRetired();
+    void renderFades(int bufferSize);
+    void finishFades();
+    bool blendWet(int band, float* gain, int bufferSize) const;
+    const float* plainOf(const juce::AudioProcessorParameter* param) const;
+    float valueOf(const juce::AudioProcessorParameter* param) const;
+    // idle :: input below IDLE_LEVEL, and how long it has to last before
+    // the DSP can be skipped
+    bool isSilent(juce::AudioBuffer<float>& buffer, int numChannels, int bufferSize) const;
+    int getTailSamples() const;
+    int getIdleSamples() const;
+    // arena layout of prepareToPlay
+    size_t getArenaBytes(double sampleRate, int chnum, int blockSize) const;
+    // channels split and compressed together: a stereo pair shares one
+    // crossover pass and linked detectors, any other layout goes one by one
+    static int groupSizeFor(int chnum) { return chnum == 2 ? 2 : 1; }
     float calculateRMS(float* buffer, int bufferSize) const;
+    void processBands(int group, float* const* data, int bufferSize);
+    void processSpectral(int channel, float* channelData, int bufferSize);
+    // spectral state of every channel, prepared on the current parameters
+    SpectralCompressor* createSpectral(double sampleRate, int chnum);
+    // builds it on the message thread once the mode is switched while playing
+    void handleAsyncUpdate() override;
+    // band, master and limiter stages of all channels
+    void processChannels(juce::AudioBuffer<float>& buffer, int bufferSize);
     //==============================================================================
     // different for each band -> array of pointers
-    juce::AudioParameterFloat** at;
-    juce::AudioParameterFloat** rt;
-    juce::AudioParameterFloat** CT;
-    juce::AudioParameterFloat** CR;
-    juce::AudioParameterFloat** pre;
-    juce::AudioParameterFloat** post;
+    juce::AudioParameterFloat* at[4];
+    juce::AudioParameterFloat* rt[4];
+    juce::AudioParameterFloat* CT[4];
+    juce::AudioParameterFloat* CR[4];
+    juce::AudioParameterFloat* pre[4];
+    juce::AudioParameterFloat* post[4];
 
     // global parameters
     juce::AudioParameterFloat* la;
     juce::AudioParameterFloat* f0;
     juce::AudioParameterFloat* f1;
+    juce::AudioParameterBool*  tp;
+    juce::AudioParameterFloat* ceiling;
+    juce::AudioParameterChoice* quality;
+    juce::AudioParameterBool*  multirate;
+    juce::AudioParameterChoice* mode;
+    juce::AudioParameterInt*   bands;
+    juce::AudioParameterChoice* slope;
+
+    // plain values, by parameter index, audio thread only
+    float* plain;
+    unsigned* applied;                   // queue position of the last event applied, by index
+    int numParams;
+    EventQueue<ParameterEvent> events;   // any producer, single consumer: processBlock
+    std::atomic<bool> eventsLost;        // queue was full, resync from the parameters
+    float preGain[4];                    // linear pre / post gains, follow the events
+    float postGain[4];
+
+    // the DSP core (Compressor, Crossover) reads these, applyParameter()
+    // writes them through the bindings
+    CompressorParameters bandSettings[4];
+    CrossoverParameters splitSettings;
+    struct { int index; float* field; } bindings[NUM_BINDINGS];
+    int numBindings;
+
+    EventQueue<Command> commands;        // any producer, single consumer: processBlock
+    EventQueue<Preset*> retired;          // applied presets, freed by whichever producer pops them
+    int solo;                            // audio thread state of the commands
+    int meterSubscribers;
+    Preset* pendingPreset;               // waits for outFade to reach 0
+    Fade soloFade[3];                    // band in the mix
+    Fade wetFade[4];                     // compressed (1) or bypassed (0)
+    Fade outFade;                        // output, dips for preset swaps
+    float* fadeBuffer[8];                // ramps of the piece (arena): solo, wet, output
+    const float* soloCurve[3];           // the ramp, nullptr when constant
+    const float* wetCurve[4];
+    const float* outCurve;
+
+    // first instance builds it, last one frees it
+    juce::SharedResourcePointer<SharedContext> shared;
+
+    // spectral path: heap, only while the mode is (or was since the last
+    // prepareToPlay) spectral. Built off the audio thread, taken at a block start
+    SpectralCompressor* spectral; // replaces crossover and bands, 1 per channel
+    std::atomic<SpectralCompressor*> spectralReady;
+    std::atomic<size_t> spectralBytes;
+    bool spectralActive;
+    int groupSize; // groupSizeFor() the prepared layout
 
-    // internal
-    Compressor** comps; // 3 per each channel
-    Allpass** filters;  // 2 per each channel
-    float** supportBuffer; // used for each channel, 3 buffs / ch
-    int supportBufferSize;
-    int solo;
+    // internal, everything below comes from the arena
+    Arena arena;
+    Compressor** comps; // 4 per channel group
+    Crossover* filters;  // 1 per channel group, splits the undelayed input
+    CircularBuffer<float>** delays; // lookahead, 3 per channel: one per band (the spectral path uses the first)
+    TruePeakLimiter limiter; // after master, linked across channels
+    float** supportBuffer; // used for each group, 3 buffs / ch of the group
+    float** sideBuffer;    // undelayed bands + master sidechain, 4 buffs / ch of the group
+    float** gainBuffer;    // gain curves of the compressors, 4 buffs (shared by a linked pair)
+    int supportBufferSize; // longest block processed at once
+    int silentSamples; // since the last block with signal, saturates at getIdleSamples()
+    const KernelTable* kernel; // best for the CPU, picked in prepareToPlay
 
     // display
-    float* iLvl;
-    float* oLvl;
-    float* gLvl;
+    float iLvl[4];
+    float oLvl[4];
+    float gLvl[4];
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MBComp01AudioProcessor)
@@ -12,6 +12,82 @@
 #include "EditorComponent.h"
 #include "PluginProcessor.h"
 
+//==============================================================================
+// colour of the band panels and curves
+static juce::Colour bandColour(int band)
+{
+    switch (band)
+    {
+    case LOW: return juce::Colours::red   .withSaturation(0.5);
+    case MID: return juce::Colours::orange.withSaturation(0.5);
+    case HHI: return juce::Colours::yellow.withSaturation(0.5);
+    case MAS: return juce::Colours::green .withSaturation(0.5);
+    default:  return juce::Colours::grey;
+    }
+}
+
+//==============================================================================
+// filmstrips
+juce::Image filmstripCache::find(const Key& key)
+{
+    auto entry = strips.find(key);
+    if (entry == strips.end()) return {};
+
+    entry->second.lastUse = ++uses;
+    return entry->second.strip;
+}
+void filmstripCache::add(const Key& key, const juce::Image& strip)
+{
+    if (strips.size() >= FILMSTRIP_MAX)
+    {
+        auto oldest = strips.begin();
+        for (auto entry = strips.begin(); entry != strips.end(); ++entry)
+            if (entry->second.lastUse < oldest->second.lastUse)
+                oldest = entry;
+        strips.erase(oldest);
+    }
+    strips[key] = { strip, ++uses };
+}
+
+void knobLookAndFeel::drawRotarySlider(juce::Graphics& g, int x, int y, int width, int height, float sliderPos,
+                                       float rotaryStartAngle, float rotaryEndAngle, juce::Slider& slider)
+{
+    // strips are rendered for the physical size, rounded up so a live
+    // resize reuses them
+    int size = juce::jmin(width, height);
+    if (size <= 0) return;
+    float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    int pixels = (int)std::ceil(size * scale / FILMSTRIP_STEP) * FILMSTRIP_STEP;
+
+    filmstripCache::Key key = {
+        pixels,
+        slider.findColour(juce::Slider::rotarySliderFillColourId).getARGB(),
+        slider.findColour(juce::Slider::rotarySliderOutlineColourId).getARGB(),
+        slider.findColour(juce::Slider::thumbColourId).getARGB(),
+        rotaryStartAngle, rotaryEndAngle, slider.isEnabled()
+    };
+
+    juce::Image strip = cache->find(key);
+    if (strip.isNull())
+    {
+        strip = juce::Image(juce::Image::ARGB, pixels, pixels * FILMSTRIP_FRAMES, true);
+        juce::Graphics sg(strip);
+        for (int frame = 0; frame < FILMSTRIP_FRAMES; frame++)
+        {
+            juce::Graphics::ScopedSaveState state(sg);
+            sg.reduceClipRegion(0, frame * pixels, pixels, pixels);
+            sg.addTransform(juce::AffineTransform::scale((float)pixels / size).translated(0.0f, (float)(frame * pixels)));
+            juce::LookAndFeel_V4::drawRotarySlider(sg, 0, 0, size, size, (float)frame / (FILMSTRIP_FRAMES - 1),
+                                                   rotaryStartAngle, rotaryEndAngle, slider);
+        }
+        cache->add(key, strip);
+    }
+
+    int frame = juce::roundToInt(juce::jlimit(0.0f, 1.0f, sliderPos) * (FILMSTRIP_FRAMES - 1));
+    g.drawImage(strip, x + (width - size) / 2, y + (height - size) / 2, size, size,
+                0, frame * pixels, pixels, pixels);
+}
+
 //==============================================================================
 // headComponent
 headComponent::headComponent() = default;
@@ -29,6 +105,11 @@ void headComponent::resized()
 {
     fontSize = juce::jmax(getHeight()-10.0f, 20.0f);
 }
+void headComponent::mouseDoubleClick(const juce::MouseEvent&)
+{
+    if (onDoubleClick != nullptr)
+        onDoubleClick();
+}
 
 void headComponent::setText(juce::String& textToDisplay)
 {
@@ -43,27 +124,26 @@ juce::String& headComponent::getText()
 //==============================================================================
 // bodyComponent
 bodyComponent::bodyComponent(MBComp01AudioProcessor& p)
-    : audioProcessor(p), bandSelect(p), knobs(p), meters(p)
+    : audioProcessor(p), bandSelect(p), knobs(p), meters(p), response(p)
 {
+    // panels are built on first use, only the selected one is shown
     bandPanel = new localComponent * [4];
     for (int band = 0; band < 4; band++)
-    {
-        bandPanel[band] = new localComponent(p, band);
-    }
+        bandPanel[band] = nullptr;
+    showPanel(bandSelect.getSelectedBand());
 
     for (int band = 0; band < 4; band++)
     {
-        addAndMakeVisible(*bandPanel[band]);
         bandSelect.getButtons()[band].onClick = [this, band]
             // ONCLICK CALLBACK (changing band)
             {
                 // Choosing band panel to make show
                 int const btn_target = band;
-                for (int panel = 0; panel < 4; panel++)
-                    bandPanel[panel]->setVisible(btn_target == panel);
+                showPanel(btn_target);
 
                 // setting current panel in child components
                 meters.setCurBand(btn_target);
+                response.setCurBand(btn_target);
                 bandSelect.setSelectedBand(btn_target);
 
                 // implementing solo function
@@ -91,6 +171,7 @@ bodyComponent::bodyComponent(MBComp01AudioProcessor& p)
     addAndMakeVisible(bandSelect);
     addAndMakeVisible(knobs);
     addAndMakeVisible(meters);
+    addAndMakeVisible(response);
 };
 bodyComponent::~bodyComponent()
 {
@@ -109,13 +190,27 @@ void bodyComponent::paint(juce::Graphics& g)
 void bodyComponent::resized() 
 {
     auto area = getLocalBounds();
+    response.setBounds( area.removeFromBottom( RESPONSE_H ) );
     auto sectionWidth = area.getWidth() / 4;
     bandSelect.setBounds( area.removeFromLeft( sectionWidth ) );
     knobs.setBounds( area.removeFromLeft( sectionWidth ) );
     meters.setBounds( area.removeFromLeft( sectionWidth ) );
     for (int band = 0; band < 4; band++)
-        bandPanel[band]->setBounds(area);
+        if (bandPanel[band] != nullptr)
+            bandPanel[band]->setBounds(area);
 };
+void bodyComponent::showPanel(int band)
+{
+    if (bandPanel[band] == nullptr)
+    {
+        bandPanel[band] = new localComponent(audioProcessor, band);
+        addChildComponent(*bandPanel[band]);
+        resized();
+    }
+    for (int panel = 0; panel < 4; panel++)
+        if (bandPanel[panel] != nullptr)
+            bandPanel[panel]->setVisible(band == panel);
+}
 
 
 //==============================================================================
@@ -204,22 +299,27 @@ knobsComponent::knobsComponent(MBComp01AudioProcessor& p)
     la.setSliderStyle(juce::Slider::RotaryVerticalDrag);
     f0.setSliderStyle(juce::Slider::RotaryVerticalDrag);
     f1.setSliderStyle(juce::Slider::RotaryVerticalDrag);
+    ceiling.setSliderStyle(juce::Slider::RotaryVerticalDrag);
 
     la.setTextBoxStyle(juce::Slider::NoTextBox, true, 0, 0);
     f0.setTextBoxStyle(juce::Slider::NoTextBox, true, 0, 0);
     f1.setTextBoxStyle(juce::Slider::NoTextBox, true, 0, 0);
+    ceiling.setTextBoxStyle(juce::Slider::NoTextBox, true, 0, 0);
 
     la.setTextValueSuffix(" ms");
     f0.setTextValueSuffix(" Hz");
     f1.setTextValueSuffix(" Hz");
+    ceiling.setTextValueSuffix(" dBTP");
 
     la.setNumDecimalPlacesToDisplay(2);
     f0.setNumDecimalPlacesToDisplay(0);
     f1.setNumDecimalPlacesToDisplay(0);
+    ceiling.setNumDecimalPlacesToDisplay(1);
 
     la.setNormalisableRange(juce::NormalisableRange<double>(minla, maxla));
     f0.setNormalisableRange(juce::NormalisableRange<double>(minf, maxf));
     f1.setNormalisableRange(juce::NormalisableRange<double>(minf, maxf));
+    ceiling.setNormalisableRange(juce::NormalisableRange<double>(minceil, maxceil));
 
     la.setSkewFactorFromMidPoint(sqrt(maxla));
     f0.setSkewFactorFromMidPoint(sqrt(minf * maxf));
@@ -228,20 +328,30 @@ knobsComponent::knobsComponent(MBComp01AudioProcessor& p)
     la.setPopupDisplayEnabled(true, true, this, -1);
     f0.setPopupDisplayEnabled(true, true, this, -1);
     f1.setPopupDisplayEnabled(true, true, this, -1);
+    ceiling.setPopupDisplayEnabled(true, true, this, -1);
 
     la.setDoubleClickReturnValue(true, defla);
     f0.setDoubleClickReturnValue(true, deff0);
     f1.setDoubleClickReturnValue(true, deff1);
+    ceiling.setDoubleClickReturnValue(true, defceil);
 
-    laLabel.setText("Lookahead Time", juce::dontSendNotification);
+    laLabel.setText("Lookahead", juce::dontSendNotification);
     f0Label.setText("Low Split", juce::dontSendNotification);
     f1Label.setText("High Split", juce::dontSendNotification);
+    ceilingLabel.setText("Ceiling", juce::dontSendNotification);
 
     laLabel.setJustificationType(juce::Justification::centred);
     f0Label.setJustificationType(juce::Justification::centred);
     f1Label.setJustificationType(juce::Justification::centred);
+    ceilingLabel.setJustificationType(juce::Justification::centred);
 
     solo.setButtonText("Solo");
+    tp.setButtonText("True Peak");
+    tp.setClickingTogglesState(true);
+    tp.setToggleState(*(audioProcessor.gettp()), juce::dontSendNotification);
+    tp.setColour(juce::TextButton::buttonColourId, juce::Colours::darkgrey);
+    tp.setColour(juce::TextButton::buttonOnColourId, juce::Colours::red);
+    updateSoloColour();
 
     la.onValueChange = [this] { *(audioProcessor.getla()) = la.getValue(); };
     f0.onValueChange = [this] 
@@ -256,36 +366,40 @@ knobsComponent::knobsComponent(MBComp01AudioProcessor& p)
             if (f1.getValue() < f0.getValue())
                 f0.setValue(f1.getValue(), juce::dontSendNotification);
         };
+    ceiling.onValueChange = [this] { *(audioProcessor.getceiling()) = ceiling.getValue(); };
+    tp.onClick = [this] { *(audioProcessor.gettp()) = tp.getToggleState(); };
 
     addAndMakeVisible(la);
     addAndMakeVisible(f0);
     addAndMakeVisible(f1);
+    addAndMakeVisible(ceiling);
     addAndMakeVisible(solo);
+    addAndMakeVisible(tp);
     addAndMakeVisible(laLabel);
     addAndMakeVisible(f0Label);
     addAndMakeVisible(f1Label);
+    addAndMakeVisible(ceilingLabel);
 }
 knobsComponent::~knobsComponent() = default;
 
 void knobsComponent::paint(juce::Graphics& g) 
 {
     g.fillAll(BG_COLOUR);
-    juce::Colour soloColour;
-    if (soloBool)
-        soloColour = juce::Colours::red;
-    else
-        soloColour = juce::Colours::darkgrey;
-    solo.setColour(juce::TextButton::buttonColourId, soloColour);
 }
 void knobsComponent::resized() 
 {
     auto area = getLocalBounds();
 
     auto knobAndLabel = area.removeFromTop(area.getHeight() / 2);
+    auto right = knobAndLabel.removeFromRight(knobAndLabel.getWidth() / 2);
     laLabel.setBounds(knobAndLabel.removeFromBottom(CHAR_H));
     la.setBounds(knobAndLabel);
+    ceilingLabel.setBounds(right.removeFromBottom(CHAR_H));
+    ceiling.setBounds(right);
 
-    solo.setBounds( area.removeFromBottom( area.getHeight() / 2 ).reduced(3) );
+    auto buttons = area.removeFromBottom( area.getHeight() / 2 );
+    tp.setBounds( buttons.removeFromRight( buttons.getWidth() / 2 ).reduced(3) );
+    solo.setBounds( buttons.reduced(3) );
 
     knobAndLabel = area.removeFromLeft(area.getWidth() / 2);
     f0Label.setBounds(knobAndLabel.removeFromBottom(CHAR_H));
@@ -308,16 +422,24 @@ bool knobsComponent::getSolo()
 void knobsComponent::toggleSolo()
 {
     soloBool = !soloBool;
+    updateSoloColour();
+}
+void knobsComponent::updateSoloColour()
+{
+    juce::Colour soloColour;
+    if (soloBool)
+        soloColour = juce::Colours::red;
+    else
+        soloColour = juce::Colours::darkgrey;
+    solo.setColour(juce::TextButton::buttonColourId, soloColour);
 }
 
 
 //==============================================================================
 // meters
 metersComponent::metersComponent(MBComp01AudioProcessor& p)
-    : audioProcessor(p), curBand(MAS)
+    : audioProcessor(p), curBand(MAS), lastFrame(0), subscribed(false)
 {
-    startTimerHz(24);
-
     inLabel   .setText("In",   juce::dontSendNotification);
     outLabel  .setText("Out",  juce::dontSendNotification);
     gainLabel .setText("Gain", juce::dontSendNotification);
@@ -341,7 +463,11 @@ metersComponent::metersComponent(MBComp01AudioProcessor& p)
     addAndMakeVisible(gainLabel);
     addAndMakeVisible(scaleLabel);
 };
-metersComponent::~metersComponent() = default;
+metersComponent::~metersComponent()
+{
+    vblank.reset();
+    subscribe(false);
+}
 
 void metersComponent::paint(juce::Graphics& g)
 {
@@ -368,9 +494,44 @@ void metersComponent::resized()
     outLabel.setBounds(quarter.removeFromBottom(CHAR_H));
     out.setBounds(quarter);
 }
-void metersComponent::timerCallback()
+void metersComponent::visibilityChanged()
 {
-    // update values
+    updateAttachment();
+}
+void metersComponent::parentHierarchyChanged()
+{
+    updateAttachment();
+}
+// the refresh callback only exists while the meters are visible on a window
+void metersComponent::updateAttachment()
+{
+    bool attach = isVisible() && getPeer() != nullptr;
+    if (attach && vblank == nullptr)
+        vblank = std::make_unique<juce::VBlankAttachment>(this, [this] { update(); });
+    else if (!attach && vblank != nullptr)
+    {
+        vblank.reset();
+        subscribe(false);
+    }
+}
+void metersComponent::subscribe(bool shouldBeSubscribed)
+{
+    if (shouldBeSubscribed != subscribed)
+        audioProcessor.subscribeMeters(shouldBeSubscribed);
+    subscribed = shouldBeSubscribed;
+}
+void metersComponent::update()
+{
+    // minimized or covered by a hidden parent: nothing to draw, nothing to measure
+    bool showing = isShowing();
+    subscribe(showing);
+    if (!showing) return;
+
+    double now = juce::Time::getMillisecondCounterHiRes();
+    if (now - lastFrame < 1000.0 / METER_FPS) return;
+    lastFrame = now;
+
+    // update values, the bars invalidate what changed
     float iDB = juce::Decibels::gainToDecibels(audioProcessor.getILvl(curBand));
     float oDB = juce::Decibels::gainToDecibels(audioProcessor.getOLvl(curBand));
     float gDB = juce::Decibels::gainToDecibels(audioProcessor.getGLvl(curBand));
@@ -380,10 +541,6 @@ void metersComponent::timerCallback()
     gain.setLevel(gDB);
 
     in.setMark(*(audioProcessor.getCT(curBand)));
-
-    in.repaint();
-    out.repaint();
-    gain.repaint();
 }
 
 void metersComponent::setCurBand(int currentBand)
@@ -392,6 +549,264 @@ void metersComponent::setCurBand(int currentBand)
 }
 
 
+//==============================================================================
+// response
+// plotted ranges
+static const float tfMin = -60, tfMax = 0;         // [dB] transfer curve, both axes
+static const float frMin = 20, frMax = 20000;      // [Hz] crossover
+static const float magMin = -24, magMax = 6;       // [dB] crossover
+static const int curvePoints = 200;
+
+static juce::Rectangle<float> transferArea(float w, float h)
+{
+    return { 4, 4, w / 2 - 8, h - 8 };
+}
+static juce::Rectangle<float> crossoverArea(float w, float h)
+{
+    return { w / 2 + 4, 4, w / 2 - 8, h - 8 };
+}
+static juce::Point<float> transferPoint(juce::Rectangle<float> area, float inDb, float outDb)
+{
+    inDb = juce::jlimit(tfMin, tfMax, inDb);
+    outDb = juce::jlimit(tfMin, tfMax, outDb);
+    return { juce::jmap(inDb, tfMin, tfMax, area.getX(), area.getRight()),
+             juce::jmap(outDb, tfMin, tfMax, area.getBottom(), area.getY()) };
+}
+static float frequencyX(juce::Rectangle<float> area, float freq)
+{
+    return area.getX() + area.getWidth() * std::log(freq / frMin) / std::log(frMax / frMin);
+}
+static float magnitudeY(juce::Rectangle<float> area, double magnitude)
+{
+    float db = juce::jlimit(magMin, magMax, juce::Decibels::gainToDecibels((float)magnitude, magMin));
+    return juce::jmap(db, magMin, magMax, area.getBottom(), area.getY());
+}
+
+// Runs on a worker thread: software image, no shared state.
+static juce::Image renderResponse(const responseSettings& s)
+{
+    juce::Image image(juce::Image::ARGB, juce::jmax(1, juce::roundToInt(s.width * s.scale)),
+                      juce::jmax(1, juce::roundToInt(s.height * s.scale)), true, juce::SoftwareImageType());
+    juce::Graphics g(image);
+    g.addTransform(juce::AffineTransform::scale(s.scale));
+    g.fillAll(BG_COLOUR);
+
+    //==========================================================================
+    // transfer curve, unity as reference
+    auto area = transferArea((float)s.width, (float)s.height);
+    g.setColour(juce::Colours::black);
+    g.fillRect(area);
+    g.setColour(juce::Colours::darkgrey);
+    for (float db = tfMin + 20; db < tfMax; db += 20)
+    {
+        auto p = transferPoint(area, db, db);
+        g.drawVerticalLine(juce::roundToInt(p.x), area.getY(), area.getBottom());
+        g.drawHorizontalLine(juce::roundToInt(p.y), area.getX(), area.getRight());
+    }
+    g.drawLine({ transferPoint(area, tfMin, tfMin), transferPoint(area, tfMax, tfMax) });
+
+    juce::Path curve;
+    for (int i = 0; i <= curvePoints; i++)
+    {
+        float in = juce::jmap((float)i / curvePoints, tfMin, tfMax);
+        auto p = transferPoint(area, in, in + Compressor::getStaticGain(in, s.CT[s.band], s.CR[s.band]));
+        if (i == 0) curve.startNewSubPath(p);
+        else        curve.lineTo(p);
+    }
+    g.setColour(bandColour(s.band));
+    g.strokePath(curve, juce::PathStrokeType(2));
+
+    //==========================================================================
+    // crossover bands and their sum, up to Nyquist
+    area = crossoverArea((float)s.width, (float)s.height);
+    g.setColour(juce::Colours::black);
+    g.fillRect(area);
+    g.setColour(juce::Colours::darkgrey);
+    for (float freq : { 100.0f, 1000.0f, 10000.0f })
+        g.drawVerticalLine(juce::roundToInt(frequencyX(area, freq)), area.getY(), area.getBottom());
+    g.drawHorizontalLine(juce::roundToInt(magnitudeY(area, 1)), area.getX(), area.getRight());
+
+    CrossoverParameters split;
+    split.f0 = s.f0;
+    split.f1 = s.f1;
+    split.slope = (float)s.slope;
+    Crossover crossover;
+    crossover.setParameters(&split);
+    crossover.setfs((float)s.fs);
+
+    juce::Path bands[3], sum;
+    for (int i = 0; i <= curvePoints; i++)
+    {
+        float freq = frMin * std::pow(frMax / frMin, (float)i / curvePoints);
+        if (freq >= 0.5 * s.fs) break;
+
+        std::complex<double> H[3];
+        crossover.getResponse(freq, H);
+        float x = frequencyX(area, freq);
+        for (int l = 0; l < 3; l++)
+        {
+            if (i == 0) bands[l].startNewSubPath(x, magnitudeY(area, std::abs(H[l])));
+            else        bands[l].lineTo(x, magnitudeY(area, std::abs(H[l])));
+        }
+        if (i == 0) sum.startNewSubPath(x, magnitudeY(area, std::abs(H[0] + H[1] + H[2])));
+        else        sum.lineTo(x, magnitudeY(area, std::abs(H[0] + H[1] + H[2])));
+    }
+    for (int l = 0; l < 3; l++)
+    {
+        g.setColour(bandColour(l).withAlpha(l == s.band || s.band == MAS ? 1.0f : 0.4f));
+        g.strokePath(bands[l], juce::PathStrokeType(1.5f));
+    }
+    g.setColour(juce::Colours::white);
+    g.strokePath(sum, juce::PathStrokeType(1));
+
+    return image;
+}
+
+responseComponent::responseComponent(MBComp01AudioProcessor& p)
+    : audioProcessor(p), workers(p.getSharedContext().getWorkers()), curBand(MAS), displayScale(1),
+    lastFrame(0), requested(), jobNumber(0), renderedNumber(0)
+{
+    setOpaque(true);
+}
+responseComponent::~responseComponent()
+{
+    vblank.reset();
+    // queued jobs go, running ones finish before the component does
+    jobSelector own(this);
+    workers.removeAllJobs(true, 1000, &own);
+    cancelPendingUpdate();
+}
+
+void responseComponent::paint(juce::Graphics& g)
+{
+    // the next render follows the display scale
+    displayScale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+    if (image.isValid())
+        g.drawImage(image, getLocalBounds().toFloat());
+    else
+        g.fillAll(BG_COLOUR);
+
+    if (!dot.isEmpty())
+    {
+        g.setColour(juce::Colours::white);
+        g.fillEllipse(dot);
+    }
+}
+void responseComponent::resized()
+{
+    dot = getDot();
+}
+void responseComponent::visibilityChanged()
+{
+    updateAttachment();
+}
+void responseComponent::parentHierarchyChanged()
+{
+    updateAttachment();
+}
+void responseComponent::setCurBand(int currentBand)
+{
+    curBand = currentBand;
+}
+void responseComponent::updateAttachment()
+{
+    bool attach = isVisible() && getPeer() != nullptr;
+    if (attach && vblank == nullptr)
+        vblank = std::make_unique<juce::VBlankAttachment>(this, [this] { update(); });
+    else if (!attach)
+        vblank.reset();
+}
+void responseComponent::update()
+{
+    if (!isShowing()) return;
+
+    double now = juce::Time::getMillisecondCounterHiRes();
+    if (now - lastFrame < 1000.0 / METER_FPS) return;
+    lastFrame = now;
+
+    // changed settings go to the workers, the old image stays until the
+    // new one arrives; a job still queued is outdated and dropped
+    responseSettings settings = getSettings();
+    if (!(settings == requested))
+    {
+        requested = settings;
+        jobSelector own(this);
+        workers.removeAllJobs(false, 0, &own);
+        workers.addJob(new renderJob(*this, settings, ++jobNumber), true);
+    }
+
+    // the dot moves: only its old and new place is repainted
+    auto next = getDot();
+    if (next != dot)
+    {
+        repaint(dot.getUnion(next).getSmallestIntegerContainer().expanded(1));
+        dot = next;
+    }
+}
+responseSettings responseComponent::getSettings() const
+{
+    responseSettings settings;
+    for (int band = 0; band < 4; band++)
+    {
+        settings.CT[band] = *(audioProcessor.getCT(band));
+        settings.CR[band] = *(audioProcessor.getCR(band));
+    }
+    settings.f0 = *(audioProcessor.getf0());
+    settings.f1 = *(audioProcessor.getf1());
+    settings.slope = audioProcessor.getslope()->getIndex();
+    settings.band = curBand;
+    settings.fs = audioProcessor.getSampleRate() > 0 ? audioProcessor.getSampleRate() : 48000.0;
+    settings.width = getWidth();
+    settings.height = getHeight();
+    settings.scale = displayScale;
+    return settings;
+}
+// input level of the band on its static curve
+juce::Rectangle<float> responseComponent::getDot() const
+{
+    float inDb = juce::Decibels::gainToDecibels(audioProcessor.getILvl(curBand), -100.0f);
+    if (inDb < tfMin || getWidth() <= 0) return {};
+
+    float outDb = inDb + Compressor::getStaticGain(inDb, *(audioProcessor.getCT(curBand)), *(audioProcessor.getCR(curBand)));
+    auto p = transferPoint(transferArea((float)getWidth(), (float)getHeight()), inDb, outDb);
+    return juce::Rectangle<float>(6, 6).withCentre(p);
+}
+void responseComponent::deliver(const juce::Image& next, juce::uint32 number)
+{
+    {
+        const juce::ScopedLock lock(jobLock);
+        if (number <= renderedNumber) return;
+        renderedNumber = number;
+        rendered = next;
+    }
+    triggerAsyncUpdate();
+}
+void responseComponent::handleAsyncUpdate()
+{
+    {
+        const juce::ScopedLock lock(jobLock);
+        image = rendered;
+    }
+    repaint();
+}
+responseComponent::renderJob::renderJob(responseComponent& o, const responseSettings& s, juce::uint32 n)
+    : juce::ThreadPoolJob("MBComp response"), owner(o), settings(s), number(n)
+{
+}
+juce::ThreadPoolJob::JobStatus responseComponent::renderJob::runJob()
+{
+    if (settings.width > 0 && settings.height > 0)
+        owner.deliver(renderResponse(settings), number);
+    return jobHasFinished;
+}
+bool responseComponent::jobSelector::isJobSuitable(juce::ThreadPoolJob* job)
+{
+    auto* render = dynamic_cast<renderJob*>(job);
+    return render != nullptr && &render->owner == owner;
+}
+
+
 //==============================================================================
 // local
 localComponent::localComponent(MBComp01AudioProcessor& p, int f_band)
@@ -485,24 +900,9 @@ localComponent::localComponent(MBComp01AudioProcessor& p, int f_band)
     addAndMakeVisible(CRLabel);
     addAndMakeVisible(CTLabel);
 
-    switch (band)
-    {
-    case LOW: background = juce::Colours::red   .withSaturation(0.5);
-        textColour = juce::Colours::black; break;
-    case MID: background = juce::Colours::orange.withSaturation(0.5); 
-        textColour = juce::Colours::black; break;
-    case HHI: background = juce::Colours::yellow.withSaturation(0.5); 
-        textColour = juce::Colours::black; break;
-    case MAS: background = juce::Colours::green .withSaturation(0.5); 
-        textColour = juce::Colours::white; break;
-    default:  background = juce::Colours::grey;
-    }
-}
-localComponent::~localComponent() = default;
+    background = bandColour(band);
+    textColour = band == MAS ? juce::Colours::white : juce::Colours::black;
 
-void localComponent::paint(juce::Graphics& g)
-{
-    g.fillAll(background);
     preLabel .setColour(juce::Label::textColourId, textColour);
     postLabel.setColour(juce::Label::textColourId, textColour);
     atLabel  .setColour(juce::Label::textColourId, textColour);
@@ -510,6 +910,12 @@ void localComponent::paint(juce::Graphics& g)
     CTLabel  .setColour(juce::Label::textColourId, textColour);
     CRLabel  .setColour(juce::Label::textColourId, textColour);
 }
+localComponent::~localComponent() = default;
+
+void localComponent::paint(juce::Graphics& g)
+{
+    g.fillAll(background);
+}
 void localComponent::resized() 
 { 
     auto left = getLocalBounds();
@@ -541,19 +947,22 @@ void localComponent::resized()
 // barComponent
 barComponent::barComponent()
     : min(-80), max(10), cur(-80), mark(100), invert(false),
-    top(juce::Colours::darkgrey), bot(juce::Colours::lightgrey)
+    top(juce::Colours::darkgrey), bot(juce::Colours::lightgrey), backgroundScale(0)
 {
-    return;
+    // covers its parent, level changes don't repaint the meters behind
+    setOpaque(true);
 };
 barComponent::~barComponent() = default;
 
 void barComponent::paint(juce::Graphics& g) 
 {
-    auto area = getLocalBounds().reduced(5).toFloat();
+    // cached empty bar, redrawn when the size or the display scale changes
+    float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (background.isNull() || scale != backgroundScale)
+        renderBackground(scale);
+    g.drawImageTransformed(background, juce::AffineTransform::scale(1 / backgroundScale));
 
-    // full bar
-    g.setColour(top);
-    g.fillRoundedRectangle(area, 5);
+    auto area = getLocalBounds().reduced(5).toFloat();
 
     // current level
     g.setColour(bot);
@@ -572,13 +981,42 @@ void barComponent::paint(juce::Graphics& g)
         g.drawLine(5, ycoord, area.getWidth()+5, ycoord, 2);
     }
 }
-void barComponent::resized() { return; }
+void barComponent::resized()
+{
+    background = juce::Image();
+}
+void barComponent::renderBackground(float scale)
+{
+    backgroundScale = scale;
+    background = juce::Image(juce::Image::RGB, juce::jmax(1, juce::roundToInt(getWidth() * scale)),
+                             juce::jmax(1, juce::roundToInt(getHeight() * scale)), false);
+
+    juce::Graphics g(background);
+    g.addTransform(juce::AffineTransform::scale(scale));
+    g.fillAll(BG_COLOUR);
+
+    // full bar
+    g.setColour(top);
+    g.fillRoundedRectangle(getLocalBounds().reduced(5).toFloat(), 5);
+}
+// top of the lit part (bottom of it when inverted), same edge either way
+int barComponent::edgeY(float level) const
+{
+    auto area = getLocalBounds().reduced(5);
+    return area.getY() + juce::roundToInt((1 - level) * area.getHeight());
+}
 
 void barComponent::setLevel(float level_in_dB)
 {
     if (level_in_dB > max) level_in_dB = max;
     if (level_in_dB < min) level_in_dB = min;
-    cur = juce::jmap(level_in_dB, min, max, 0.0f, 1.0f);
+    float next = juce::jmap(level_in_dB, min, max, 0.0f, 1.0f);
+
+    // only the strip between the edges changes, plus the rounded corners
+    int oldY = edgeY(cur), newY = edgeY(next);
+    cur = next;
+    if (oldY != newY)
+        repaint(0, juce::jmin(oldY, newY) - 5, getWidth(), std::abs(newY - oldY) + 10);
 }
 void barComponent::setMax(float maxVal)
 {
@@ -594,11 +1032,15 @@ void barComponent::setMin(float minVal)
 }
 void barComponent::setMark(float markVal)
 {
+    if (markVal == mark) return;
     mark = markVal;
+    repaint();
 }
 void barComponent::setTopColour(juce::Colour topColour)
 {
     top = topColour;
+    background = juce::Image();
+    repaint();
 }
 void barComponent::setBotColour(juce::Colour botColour)
 {
@@ -621,7 +1063,17 @@ scaleComponent::scaleComponent()
     dbLabels = new juce::Label[4];
 
     for (int n = 0; n < 4; n++)
+    {
+        juce::String labelText;
+        labelText += -20 * n;
+        dbLabels[n].setText(labelText, juce::dontSendNotification);
+        dbLabels[n].setJustificationType(juce::Justification::right);
+        dbLabels[n].setFont(10);
         addAndMakeVisible(dbLabels[n]);
+    }
+
+    // ticks and labels never change, repaints come from the cached image
+    setBufferedToImage(true);
 };
 scaleComponent::~scaleComponent()
 {
@@ -641,17 +1093,13 @@ void scaleComponent::paint(juce::Graphics& g)
     {
         g.drawLine(w - d_w, h - n * d_h, w, h - n * d_h, 1);
     }
-
+};
+void scaleComponent::resized()
+{
+    float d_h = getHeight() / 9.0f;
     for (int n = 0; n < 4; n++)
     {
-        juce::String labelText;
-        labelText += -20 * n;
-        dbLabels[n].setText(labelText, juce::dontSendNotification);
-        dbLabels[n].setJustificationType(juce::Justification::right);
-
         float mid_height = (2 * n +1) * d_h;
         dbLabels[n].setBounds(0, mid_height - CHAR_H / 2, 23, CHAR_H);
-        dbLabels[n].setFont(10);
     }
-};
-void scaleComponent::resized() { return; }
\ No newline at end of file
+}
@@ -14,6 +14,46 @@
 #include <juce_audio_basics/juce_audio_basics.h>
 #include "defines.h"
 #include "PluginProcessor.h"
+#include <compare>
+#include <map>
+
+// Knob frames for every slider position, one strip per physical knob size
+// and colour set. One cache for the process (SharedResourcePointer), so
+// editors share the strips instead of each building its own paths.
+class filmstripCache
+{
+public:
+    struct Key {
+        int pixels;
+        juce::uint32 fill, outline, thumb;
+        float start, end;
+        bool enabled;
+
+        auto operator<=>(const Key&) const = default;
+    };
+    //==========================================================================
+    // null when not cached
+    juce::Image find(const Key& key);
+    void add(const Key& key, const juce::Image& strip);
+    //==========================================================================
+private:
+    struct Entry {
+        juce::Image strip;
+        juce::uint64 lastUse;
+    };
+    std::map<Key, Entry> strips;
+    juce::uint64 uses = 0;
+};
+// Rotary sliders drawn from the filmstrips of the default look.
+class knobLookAndFeel : public juce::LookAndFeel_V4
+{
+public:
+    void drawRotarySlider(juce::Graphics&, int x, int y, int width, int height, float sliderPos,
+                          float rotaryStartAngle, float rotaryEndAngle, juce::Slider&) override;
+    //==========================================================================
+private:
+    juce::SharedResourcePointer<filmstripCache> cache;
+};
 
 class scaleComponent : public juce::Component
 {
@@ -27,6 +67,8 @@ public:
 private:
     juce::Label* dbLabels;
 };
+// Level bar. The empty bar is a cached layer, a level change only
+// invalidates the strip between the old and the new edge.
 class barComponent : public juce::Component
 {
 public:
@@ -46,9 +88,14 @@ public:
     bool getInvert();
     //==========================================================================
 private:
+    int edgeY(float level) const;
+    void renderBackground(float scale);
+
     float min, max, cur, mark;
     juce::Colour top, bot;
     bool invert;
+    juce::Image background; // BG and the empty bar, in physical pixels
+    float backgroundScale;
 };
 
 class localComponent : public juce::Component
@@ -101,14 +148,18 @@ public:
     void toggleSolo();
     //==========================================================================
 private:
+    void updateSoloColour();
+
     MBComp01AudioProcessor& audioProcessor;
-    juce::Slider la, f0, f1;
-    juce::TextButton solo;
-    juce::Label laLabel, f0Label, f1Label;
+    juce::Slider la, f0, f1, ceiling;
+    juce::TextButton solo, tp;
+    juce::Label laLabel, f0Label, f1Label, ceilingLabel;
     bool soloBool;
 };
-class metersComponent : public juce::Component,
-                        public juce::Timer
+// Updated on the display refresh (at most METER_FPS) while it is on
+// screen. Hidden or minimized it neither draws nor keeps the processor
+// measuring levels.
+class metersComponent : public juce::Component
 {
 public:
     metersComponent(MBComp01AudioProcessor& p);
@@ -116,16 +167,98 @@ public:
     //==========================================================================
     void paint(juce::Graphics& g) override;
     void resized() override;
-    void timerCallback() override;
+    void visibilityChanged() override;
+    void parentHierarchyChanged() override;
     //==========================================================================
     void setCurBand(int currentBand);
     //==========================================================================
 private:
+    void updateAttachment();
+    void subscribe(bool shouldBeSubscribed);
+    void update();
+
     MBComp01AudioProcessor& audioProcessor;
     scaleComponent scale;
     barComponent in, gain, out;
     juce::Label inLabel, gainLabel, outLabel, scaleLabel;
     int curBand;
+    std::unique_ptr<juce::VBlankAttachment> vblank;
+    double lastFrame; // [ms]
+    bool subscribed;
+};
+
+// Settings a response image is rendered for.
+struct responseSettings {
+    float CT[4], CR[4];
+    float f0, f1;
+    int slope, band;
+    double fs;
+    int width, height;
+    float scale;
+
+    bool operator==(const responseSettings&) const = default;
+};
+// Static compression curve of the selected band with a live input level
+// dot, and the magnitude response of the crossover bands and their sum.
+// The curves are rendered on the shared workers (SharedContext) when a
+// setting changes, paint() only draws the cached image and the dot.
+class responseComponent : public juce::Component,
+                          private juce::AsyncUpdater
+{
+public:
+    responseComponent(MBComp01AudioProcessor& p);
+    ~responseComponent() override;
+    //==========================================================================
+    void paint(juce::Graphics&) override;
+    void resized() override;
+    void visibilityChanged() override;
+    void parentHierarchyChanged() override;
+    //==========================================================================
+    void setCurBand(int currentBand);
+    //==========================================================================
+private:
+    // one render, owned by the pool
+    class renderJob : public juce::ThreadPoolJob
+    {
+    public:
+        renderJob(responseComponent& o, const responseSettings& s, juce::uint32 n);
+        JobStatus runJob() override;
+
+        responseComponent& owner;
+        responseSettings settings;
+        juce::uint32 number;
+    };
+    // the jobs of one component
+    struct jobSelector : public juce::ThreadPool::JobSelector
+    {
+        jobSelector(const responseComponent* o) : owner(o) {}
+        bool isJobSuitable(juce::ThreadPoolJob* job) override;
+
+        const responseComponent* owner;
+    };
+
+    void handleAsyncUpdate() override;
+    void updateAttachment();
+    void update();
+    void deliver(const juce::Image& next, juce::uint32 number);
+    responseSettings getSettings() const;
+    juce::Rectangle<float> getDot() const;
+
+    MBComp01AudioProcessor& audioProcessor;
+    juce::ThreadPool& workers;
+    int curBand;
+    float displayScale;
+    juce::Rectangle<float> dot;
+    std::unique_ptr<juce::VBlankAttachment> vblank;
+    double lastFrame; // [ms]
+
+    responseSettings requested;  // last settings sent to the workers
+    juce::uint32 jobNumber;      // of the last job sent
+    juce::Image image;           // shown
+
+    juce::CriticalSection jobLock; // guards the members below
+    juce::uint32 renderedNumber;   // jobs may finish out of order
+    juce::Image rendered;
 };
 
 class headComponent : public juce::Component
@@ -136,9 +269,12 @@ public:
     //==========================================================================
     void paint(juce::Graphics&) override;
     void resized() override;
+    void mouseDoubleClick(const juce::MouseEvent&) override;
     //==========================================================================
     void setText(juce::String& textToDisplay);
     juce::String& getText();
+
+    std::function<void()> onDoubleClick;
     //==========================================================================
 private:
     juce::String text;
@@ -154,10 +290,13 @@ public:
     void resized() override;
     //==========================================================================
 private:
+    void showPanel(int band);
+
     MBComp01AudioProcessor& audioProcessor;
 
     bandSelectComponent bandSelect;
     knobsComponent knobs;
     metersComponent meters;
-    localComponent** bandPanel;
+    responseComponent response;
+    localComponent** bandPanel; // nullptr until the band is first selected
 };
\ No newline at end of file
@@ -0,0 +1,201 @@
+/*
+  ==============================================================================
+
+    KernelBody.h
+    Created: 19 Oct 2026 9:11:20pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+// No include guard: every Kernels*.cpp includes this inside an anonymous
+// namespace, so each instruction set gets its own copy of the inline
+// helpers (float4 included) and the linker never mixes them.
+
+#include "SIMD.h"
+
+//==============================================================================
+void crossover(const float* input, float** bands, int n,
+               const float (*coef)[5][4], float (*state)[2][8], int stages)
+{
+    float4 b0[CX_MAX_STAGES], b1[CX_MAX_STAGES], b2[CX_MAX_STAGES], a1[CX_MAX_STAGES], a2[CX_MAX_STAGES];
+    float4 s1[CX_MAX_STAGES], s2[CX_MAX_STAGES];
+    for (int s = 0; s < stages; s++)
+    {
+        b0[s] = float4::load(coef[s][0]);
+        b1[s] = float4::load(coef[s][1]);
+        b2[s] = float4::load(coef[s][2]);
+        a1[s] = float4::load(coef[s][3]);
+        a2[s] = float4::load(coef[s][4]);
+        s1[s] = float4::load(state[s][0]);
+        s2[s] = float4::load(state[s][1]);
+    }
+
+    float out[4];
+    for (int i = 0; i < n; i++)
+    {
+        float4 x = float4::broadcast(input[i]);
+        for (int s = 0; s < stages; s++)
+        {
+            float4 y = float4::mulAdd(b0[s], x, s1[s]);
+            s1[s] = float4::mulAdd(b1[s], x, s2[s]) - a1[s] * y;
+            s2[s] = b2[s] * x - a2[s] * y;
+            x = y;
+        }
+        x.store(out);
+        bands[0][i] = out[0];
+        bands[1][i] = out[1];
+        bands[2][i] = out[2];
+    }
+
+    for (int s = 0; s < stages; s++)
+    {
+        s1[s].store(state[s][0]);
+        s2[s].store(state[s][1]);
+    }
+}
+// both channels in the lanes of a float8, one cascade for the pair
+void crossoverStereo(const float* const* input, float** const* bands, int n,
+                     const float (*coef)[5][4], float (*state)[2][8], int stages)
+{
+    float8 b0[CX_MAX_STAGES], b1[CX_MAX_STAGES], b2[CX_MAX_STAGES], a1[CX_MAX_STAGES], a2[CX_MAX_STAGES];
+    float8 s1[CX_MAX_STAGES], s2[CX_MAX_STAGES];
+    for (int s = 0; s < stages; s++)
+    {
+        b0[s] = float8::dup(float4::load(coef[s][0]));
+        b1[s] = float8::dup(float4::load(coef[s][1]));
+        b2[s] = float8::dup(float4::load(coef[s][2]));
+        a1[s] = float8::dup(float4::load(coef[s][3]));
+        a2[s] = float8::dup(float4::load(coef[s][4]));
+        s1[s] = float8::load(state[s][0]);
+        s2[s] = float8::load(state[s][1]);
+    }
+
+    float out[8];
+    for (int i = 0; i < n; i++)
+    {
+        float8 x = float8::broadcast(input[0][i], input[1][i]);
+        for (int s = 0; s < stages; s++)
+        {
+            float8 y = float8::mulAdd(b0[s], x, s1[s]);
+            s1[s] = float8::mulAdd(b1[s], x, s2[s]) - a1[s] * y;
+            s2[s] = b2[s] * x - a2[s] * y;
+            x = y;
+        }
+        x.store(out);
+        for (int band = 0; band < 3; band++)
+        {
+            bands[0][band][i] = out[band];
+            bands[1][band][i] = out[4 + band];
+        }
+    }
+
+    for (int s = 0; s < stages; s++)
+    {
+        s1[s].store(state[s][0]);
+        s2[s].store(state[s][1]);
+    }
+}
+//==============================================================================
+int truePeak(const float* input, float* h, int pos, int n,
+             const float (*taps)[4], int numTaps, float* peak)
+{
+    for (int i = 0; i < n; i++)
+    {
+        pos = (pos == 0) ? numTaps - 1 : pos - 1;
+        h[pos] = h[pos + numTaps] = input[i];
+
+        float4 acc = float4::zero();
+        for (int j = 0; j < numTaps; j++)
+            acc = float4::mulAdd(float4::load(taps[j]), float4::broadcast(h[pos + j]), acc);
+
+        float p = float4::abs(acc).hmax();
+        if (p > peak[i]) peak[i] = p;
+    }
+    return pos;
+}
+// both channels of a sample per pass, two independent accumulator chains
+int truePeakStereo(const float* const* input, float* h, int pos, int n,
+                   const float (*taps)[4], int numTaps, float* peak)
+{
+    for (int i = 0; i < n; i++)
+    {
+        pos = (pos == 0) ? numTaps - 1 : pos - 1;
+        h[2 * pos] = h[2 * (pos + numTaps)] = input[0][i];
+        h[2 * pos + 1] = h[2 * (pos + numTaps) + 1] = input[1][i];
+
+        const float* hp = h + 2 * pos;
+        float4 accL = float4::zero(), accR = float4::zero();
+        for (int j = 0; j < numTaps; j++)
+        {
+            float4 t = float4::load(taps[j]);
+            accL = float4::mulAdd(t, float4::broadcast(hp[2 * j]), accL);
+            accR = float4::mulAdd(t, float4::broadcast(hp[2 * j + 1]), accR);
+        }
+
+        float p = float4::max(float4::abs(accL), float4::abs(accR)).hmax();
+        if (p > peak[i]) peak[i] = p;
+    }
+    return pos;
+}
+void powerSpectrum(const float* X, float* P, int bins)
+{
+    for (int k = 0; k < bins; k += 4)
+    {
+        float4 re, im;
+        float4::deinterleave(float4::load(X + 2 * k), float4::load(X + 2 * k + 4), re, im);
+        float4::mulAdd(re, re, im * im).store(P + k);
+    }
+}
+float sumSquares(const float* x, int n)
+{
+    float4 acc = float4::zero();
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        float4 v = float4::load(x + i);
+        acc = float4::mulAdd(v, v, acc);
+    }
+    float lanes[4];
+    acc.store(lanes);
+    float sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; i < n; i++)
+        sum += x[i] * x[i];
+    return sum;
+}
+//==============================================================================
+// plain loops, the compiler vectorizes them at the width of the target
+void scale(float* x, float gain, int n)
+{
+    for (int i = 0; i < n; i++)
+        x[i] *= gain;
+}
+void applyGain(float* x, const float* gain, float post, int n)
+{
+    for (int i = 0; i < n; i++)
+        x[i] *= gain[i] * post;
+}
+void spectralGain(float* X, const float* gain, int bins)
+{
+    for (int k = 0; k < bins; k += 4)
+    {
+        float4 lo, hi;
+        float4 g4 = float4::load(gain + k);
+        float4::interleave(g4, g4, lo, hi);
+        (float4::load(X + 2 * k) * lo).store(X + 2 * k);
+        (float4::load(X + 2 * k + 4) * hi).store(X + 2 * k + 4);
+    }
+}
+void mix(float* out, const float* in, float gain, int n)
+{
+    for (int i = 0; i < n; i++)
+        out[i] += in[i] * gain;
+}
+void mixGain(float* out, const float* in, const float* gain, float post, int n)
+{
+    for (int i = 0; i < n; i++)
+        out[i] += in[i] * gain[i] * post;
+}
+
+#define MBCOMP_KERNEL_TABLE(isa) { isa, crossover, crossoverStereo, truePeak, truePeakStereo, powerSpectrum, sumSquares, \
+                                   scale, applyGain, spectralGain, mix, mixGain }
@@ -0,0 +1,35 @@
+# DSP kernels ##################################################################
+# Adds the kernel translation units to a target (MBCompCore). Every
+# instruction set gets its own file and compile flags, kernels::get() picks
+# one at run time. The include path and MBCOMP_X86_KERNELS go to the users of
+# the target as well.
+
+function(mbcomp_add_kernels target)
+    set(dir ${CMAKE_SOURCE_DIR}/src/kernels)
+
+    target_sources(${target} PRIVATE
+        ${dir}/Kernels.cpp
+        ${dir}/KernelsBaseline.cpp
+        )
+    target_include_directories(${target} PUBLIC ${dir})
+
+    if(CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64|amd64|i.86|x86)$")
+        target_sources(${target} PRIVATE
+            ${dir}/KernelsAVX2.cpp
+            ${dir}/KernelsAVX512.cpp
+            )
+        target_compile_definitions(${target} PUBLIC MBCOMP_X86_KERNELS=1)
+
+        if(MSVC)
+            set_source_files_properties(${dir}/KernelsAVX2.cpp TARGET_DIRECTORY ${target}
+                PROPERTIES COMPILE_OPTIONS "/arch:AVX2")
+            set_source_files_properties(${dir}/KernelsAVX512.cpp TARGET_DIRECTORY ${target}
+                PROPERTIES COMPILE_OPTIONS "/arch:AVX512")
+        else()
+            set_source_files_properties(${dir}/KernelsAVX2.cpp TARGET_DIRECTORY ${target}
+                PROPERTIES COMPILE_OPTIONS "-mavx2;-mfma")
+            set_source_files_properties(${dir}/KernelsAVX512.cpp TARGET_DIRECTORY ${target}
+                PROPERTIES COMPILE_OPTIONS "-mavx512f;-mavx512vl;-mfma")
+        endif()
+    endif()
+endfunction()
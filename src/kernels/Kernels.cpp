@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    Kernels.cpp
+    Created: 19 Oct 2026 9:26:37pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#include "Kernels.h"
+
+#if MBCOMP_X86_KERNELS && defined(_MSC_VER)
+ #include <intrin.h>
+ #include <immintrin.h>
+#endif
+
+#if MBCOMP_X86_KERNELS
+// CPU and OS support of the instruction sets, without JUCE (the kernels are
+// part of the core library)
+enum { CPU_AVX2 = 1, CPU_AVX512 = 2 };
+
+static int detectCpu()
+{
+ #if defined(_MSC_VER)
+    int r[4];
+    __cpuid(r, 0);
+    if (r[0] < 7) return 0;
+    __cpuid(r, 1);
+    const bool fma = (r[2] & (1 << 12)) != 0;
+    const bool osxsave = (r[2] & (1 << 27)) != 0;
+    if (!osxsave) return 0;
+    const unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(r, 7, 0);
+    const bool avx2 = fma && (xcr0 & 0x06) == 0x06 && (r[1] & (1 << 5)) != 0;
+    const bool avx512 = avx2 && (xcr0 & 0xe6) == 0xe6 && (r[1] & (1 << 16)) != 0 && (r[1] & (1u << 31)) != 0;
+ #else
+    __builtin_cpu_init();
+    const bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    const bool avx512 = avx2 && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl");
+ #endif
+    return (avx2 ? CPU_AVX2 : 0) | (avx512 ? CPU_AVX512 : 0);
+}
+#endif
+
+static const KernelTable& selectKernels()
+{
+#if MBCOMP_X86_KERNELS
+    const int cpu = detectCpu();
+    if (cpu & CPU_AVX512)
+        return kernels::avx512;
+    if (cpu & CPU_AVX2)
+        return kernels::avx2;
+#endif
+    return kernels::baseline;
+}
+
+const KernelTable& kernels::get()
+{
+    static const KernelTable& table = selectKernels();
+    return table;
+}
@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    Kernels.h
+    Created: 19 Oct 2026 9:04:46pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#define CX_MAX_STAGES   8       // crossover biquads per band (LR8)
+
+// Hot loops of the processors, compiled once per instruction set
+// (KernelBody.h in every Kernels*.cpp) and picked at run time. Everything
+// works on plain arrays, so the table can be swapped without touching the
+// processors' state.
+// The compressor's detector and gain computer are not in here. The peak
+// hold and the envelope follower are a serial recursion, one sample at a
+// time. The decimator FIR and the gain interpolation run in its shadow in
+// the scalar loop; taken out as table calls (a FIR per decimated sample, a
+// gain curve per control period) they measured slower, except for the
+// longest FIR.
+struct KernelTable {
+    const char* name;
+
+    //==================================================================
+    // filter: TDF-II biquad cascade, the four lanes run side by side,
+    // lanes 0..2 are written to bands[0..2]. The state of a section holds
+    // two channels interleaved (s1 and s2 of channel 0, then channel 1),
+    // the mono pass uses the first
+    void (*crossover)(const float* input, float** bands, int n,
+                      const float (*coef)[5][4], float (*state)[2][8], int stages);
+    // the same for input[0..1] into bands[0..1][0..2], both cascades in
+    // one pass over the shared coefficients
+    void (*crossoverStereo)(const float* const* input, float** const* bands, int n,
+                            const float (*coef)[5][4], float (*state)[2][8], int stages);
+
+    //==================================================================
+    // detectors
+    // polyphase true peak of every input sample into peak[] (max with what
+    // is there), h is the mirrored history; returns the new position
+    int (*truePeak)(const float* input, float* h, int pos, int n,
+                    const float (*taps)[4], int numTaps, float* peak);
+    // the same for input[0..1], h holds both channels interleaved
+    int (*truePeakStereo)(const float* const* input, float* h, int pos, int n,
+                          const float (*taps)[4], int numTaps, float* peak);
+    // |X|^2 of interleaved complex bins, works in groups of 4 bins (the
+    // arrays are padded up to the next multiple)
+    void (*powerSpectrum)(const float* X, float* P, int bins);
+    float (*sumSquares)(const float* x, int n);
+
+    //==================================================================
+    // gain and mixing
+    void (*scale)(float* x, float gain, int n);                             // x *= gain
+    void (*applyGain)(float* x, const float* gain, float post, int n);      // x *= gain * post
+    void (*spectralGain)(float* X, const float* gain, int bins);            // complex bins *= gain, groups of 4
+    void (*mix)(float* out, const float* in, float gain, int n);            // out += in * gain
+    void (*mixGain)(float* out, const float* in, const float* gain, float post, int n);
+};
+
+namespace kernels {
+    // SSE2 on x86, NEON on ARM, plain C++ elsewhere
+    extern const KernelTable baseline;
+#if MBCOMP_X86_KERNELS
+    extern const KernelTable avx2;
+    extern const KernelTable avx512;
+#endif
+
+    // The best table the CPU runs, chosen on the first call.
+    const KernelTable& get();
+}
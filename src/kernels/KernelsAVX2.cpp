@@ -0,0 +1,24 @@
+/*
+  ==============================================================================
+
+    KernelsAVX2.cpp
+    Created: 19 Oct 2026 9:20:02pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+// Compiled with AVX2 + FMA (see Kernels.cmake), x86 only. The float4
+// kernels get FMA and VEX encoding, the plain loops 256 bit vectors.
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <immintrin.h>
+#include "Kernels.h"
+
+namespace {
+#include "KernelBody.h"
+}
+
+const KernelTable kernels::avx2 = MBCOMP_KERNEL_TABLE("AVX2");
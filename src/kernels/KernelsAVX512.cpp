@@ -0,0 +1,24 @@
+/*
+  ==============================================================================
+
+    KernelsAVX512.cpp
+    Created: 19 Oct 2026 9:20:02pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+// Compiled with AVX-512 F/VL (see Kernels.cmake), x86 only. The plain loops
+// get 512 bit vectors and masked tails.
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <immintrin.h>
+#include "Kernels.h"
+
+namespace {
+#include "KernelBody.h"
+}
+
+const KernelTable kernels::avx512 = MBCOMP_KERNEL_TABLE("AVX-512");
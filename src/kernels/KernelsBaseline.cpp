@@ -0,0 +1,33 @@
+/*
+  ==============================================================================
+
+    KernelsBaseline.cpp
+    Created: 19 Oct 2026 9:20:02pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+// Compiled with the target's default flags: SSE2 on x86-64, NEON on ARM64.
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+ #include <arm_neon.h>
+#endif
+#include "Kernels.h"
+
+namespace {
+#include "KernelBody.h"
+}
+
+#if MBCOMP_SIMD_SSE
+const KernelTable kernels::baseline = MBCOMP_KERNEL_TABLE("SSE2");
+#elif MBCOMP_SIMD_NEON
+const KernelTable kernels::baseline = MBCOMP_KERNEL_TABLE("NEON");
+#else
+const KernelTable kernels::baseline = MBCOMP_KERNEL_TABLE("scalar");
+#endif
@@ -0,0 +1,253 @@
+/*
+  ==============================================================================
+
+    SIMD.h
+    Created: 19 Oct 2026 1:02:11pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define MBCOMP_SIMD_SSE 1
+ #include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+ #define MBCOMP_SIMD_NEON 1
+ #include <arm_neon.h>
+#else
+ #define MBCOMP_SIMD_SCALAR 1
+ #include <cmath>
+ #include <cstdint>
+ #include <cstring>
+#endif
+
+// Four packed floats. Lanes are used for polyphase phases, crossover
+// bands, or parallel streams, depending on the kernel.
+struct float4 {
+    //==================================================================
+#if MBCOMP_SIMD_SSE
+    __m128 v;
+
+    static float4 load(const float* p)  { return { _mm_loadu_ps(p) }; }
+    static float4 broadcast(float x)    { return { _mm_set1_ps(x) }; }
+    static float4 zero()                { return { _mm_setzero_ps() }; }
+    void store(float* p) const          { _mm_storeu_ps(p, v); }
+
+    friend float4 operator+(float4 a, float4 b) { return { _mm_add_ps(a.v, b.v) }; }
+    friend float4 operator-(float4 a, float4 b) { return { _mm_sub_ps(a.v, b.v) }; }
+    friend float4 operator*(float4 a, float4 b) { return { _mm_mul_ps(a.v, b.v) }; }
+
+    // a * b + c
+    static float4 mulAdd(float4 a, float4 b, float4 c)
+    {
+     #if defined(__FMA__) || defined(__AVX2__)
+        return { _mm_fmadd_ps(a.v, b.v, c.v) };
+     #else
+        return { _mm_add_ps(_mm_mul_ps(a.v, b.v), c.v) };
+     #endif
+    }
+    static float4 max(float4 a, float4 b) { return { _mm_max_ps(a.v, b.v) }; }
+    static float4 min(float4 a, float4 b) { return { _mm_min_ps(a.v, b.v) }; }
+    static float4 abs(float4 a)           { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+    // 2^n for integral n in [-126, 127]
+    static float4 exp2int(float4 n)
+    {
+        __m128i i = _mm_add_epi32(_mm_cvtps_epi32(n.v), _mm_set1_epi32(127));
+        return { _mm_castsi128_ps(_mm_slli_epi32(i, 23)) };
+    }
+    // |x| = m * 2^e with m in [sqrt(1/2), sqrt(2)), returns m
+    static float4 frexp(float4 x, float4& e)
+    {
+        __m128i i = _mm_sub_epi32(_mm_and_si128(_mm_castps_si128(x.v), _mm_set1_epi32(0x7fffffff)),
+                                  _mm_set1_epi32(0x3f3504f3));
+        e.v = _mm_cvtepi32_ps(_mm_srai_epi32(i, 23));
+        return { _mm_castsi128_ps(_mm_add_epi32(_mm_and_si128(i, _mm_set1_epi32(0x007fffff)),
+                                                _mm_set1_epi32(0x3f3504f3))) };
+    }
+    float hmax() const
+    {
+        __m128 m = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+        m = _mm_max_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+        return _mm_cvtss_f32(m);
+    }
+    // {a0 a1 a2 a3} {b0 b1 b2 b3} -> {a0 a2 b0 b2} {a1 a3 b1 b3}
+    static void deinterleave(float4 a, float4 b, float4& even, float4& odd)
+    {
+        even.v = _mm_shuffle_ps(a.v, b.v, _MM_SHUFFLE(2, 0, 2, 0));
+        odd.v = _mm_shuffle_ps(a.v, b.v, _MM_SHUFFLE(3, 1, 3, 1));
+    }
+    // {a0 a1 a2 a3} {b0 b1 b2 b3} -> {a0 b0 a1 b1} {a2 b2 a3 b3}
+    static void interleave(float4 a, float4 b, float4& lo, float4& hi)
+    {
+        lo.v = _mm_unpacklo_ps(a.v, b.v);
+        hi.v = _mm_unpackhi_ps(a.v, b.v);
+    }
+#elif MBCOMP_SIMD_NEON
+    float32x4_t v;
+
+    static float4 load(const float* p)  { return { vld1q_f32(p) }; }
+    static float4 broadcast(float x)    { return { vdupq_n_f32(x) }; }
+    static float4 zero()                { return { vdupq_n_f32(0.0f) }; }
+    void store(float* p) const          { vst1q_f32(p, v); }
+
+    friend float4 operator+(float4 a, float4 b) { return { vaddq_f32(a.v, b.v) }; }
+    friend float4 operator-(float4 a, float4 b) { return { vsubq_f32(a.v, b.v) }; }
+    friend float4 operator*(float4 a, float4 b) { return { vmulq_f32(a.v, b.v) }; }
+
+    static float4 mulAdd(float4 a, float4 b, float4 c) { return { vmlaq_f32(c.v, a.v, b.v) }; }
+    static float4 max(float4 a, float4 b) { return { vmaxq_f32(a.v, b.v) }; }
+    static float4 min(float4 a, float4 b) { return { vminq_f32(a.v, b.v) }; }
+    static float4 abs(float4 a)           { return { vabsq_f32(a.v) }; }
+    static float4 exp2int(float4 n)
+    {
+        int32x4_t i = vaddq_s32(vcvtq_s32_f32(n.v), vdupq_n_s32(127));
+        return { vreinterpretq_f32_s32(vshlq_n_s32(i, 23)) };
+    }
+    static float4 frexp(float4 x, float4& e)
+    {
+        int32x4_t i = vsubq_s32(vandq_s32(vreinterpretq_s32_f32(x.v), vdupq_n_s32(0x7fffffff)),
+                                vdupq_n_s32(0x3f3504f3));
+        e.v = vcvtq_f32_s32(vshrq_n_s32(i, 23));
+        return { vreinterpretq_f32_s32(vaddq_s32(vandq_s32(i, vdupq_n_s32(0x007fffff)),
+                                                 vdupq_n_s32(0x3f3504f3))) };
+    }
+    float hmax() const
+    {
+        float32x2_t m = vpmax_f32(vget_low_f32(v), vget_high_f32(v));
+        m = vpmax_f32(m, m);
+        return vget_lane_f32(m, 0);
+    }
+    static void deinterleave(float4 a, float4 b, float4& even, float4& odd)
+    {
+        float32x4x2_t r = vuzpq_f32(a.v, b.v);
+        even.v = r.val[0];
+        odd.v = r.val[1];
+    }
+    static void interleave(float4 a, float4 b, float4& lo, float4& hi)
+    {
+        float32x4x2_t r = vzipq_f32(a.v, b.v);
+        lo.v = r.val[0];
+        hi.v = r.val[1];
+    }
+#else
+    float v[4];
+
+    static float4 load(const float* p)  { return { { p[0], p[1], p[2], p[3] } }; }
+    static float4 broadcast(float x)    { return { { x, x, x, x } }; }
+    static float4 zero()                { return broadcast(0.0f); }
+    void store(float* p) const          { for (int l = 0; l < 4; l++) p[l] = v[l]; }
+
+    friend float4 operator+(float4 a, float4 b) { for (int l = 0; l < 4; l++) a.v[l] += b.v[l]; return a; }
+    friend float4 operator-(float4 a, float4 b) { for (int l = 0; l < 4; l++) a.v[l] -= b.v[l]; return a; }
+    friend float4 operator*(float4 a, float4 b) { for (int l = 0; l < 4; l++) a.v[l] *= b.v[l]; return a; }
+
+    static float4 mulAdd(float4 a, float4 b, float4 c) { return a * b + c; }
+    static float4 max(float4 a, float4 b)
+    {
+        for (int l = 0; l < 4; l++) a.v[l] = a.v[l] > b.v[l] ? a.v[l] : b.v[l];
+        return a;
+    }
+    static float4 min(float4 a, float4 b)
+    {
+        for (int l = 0; l < 4; l++) a.v[l] = a.v[l] < b.v[l] ? a.v[l] : b.v[l];
+        return a;
+    }
+    static float4 abs(float4 a)
+    {
+        for (int l = 0; l < 4; l++) a.v[l] = std::fabs(a.v[l]);
+        return a;
+    }
+    static float4 exp2int(float4 n)
+    {
+        for (int l = 0; l < 4; l++)
+        {
+            std::int32_t i = ((std::int32_t)n.v[l] + 127) << 23;
+            std::memcpy(&n.v[l], &i, sizeof(float));
+        }
+        return n;
+    }
+    static float4 frexp(float4 x, float4& e)
+    {
+        for (int l = 0; l < 4; l++)
+        {
+            std::int32_t i;
+            std::memcpy(&i, &x.v[l], sizeof(float));
+            i = (i & 0x7fffffff) - 0x3f3504f3;
+            e.v[l] = (float)(i >> 23);
+            i = (i & 0x007fffff) + 0x3f3504f3;
+            std::memcpy(&x.v[l], &i, sizeof(float));
+        }
+        return x;
+    }
+    float hmax() const
+    {
+        float m = v[0];
+        for (int l = 1; l < 4; l++) if (v[l] > m) m = v[l];
+        return m;
+    }
+    static void deinterleave(float4 a, float4 b, float4& even, float4& odd)
+    {
+        even = { { a.v[0], a.v[2], b.v[0], b.v[2] } };
+        odd = { { a.v[1], a.v[3], b.v[1], b.v[3] } };
+    }
+    static void interleave(float4 a, float4 b, float4& lo, float4& hi)
+    {
+        lo = { { a.v[0], b.v[0], a.v[1], b.v[1] } };
+        hi = { { a.v[2], b.v[2], a.v[3], b.v[3] } };
+    }
+#endif
+};
+
+// Eight packed floats, two float4 side by side: the lanes of a stereo pair
+// (the crossover state of both channels). One register with AVX, a pair of
+// float4 otherwise.
+struct float8 {
+    //==================================================================
+#if MBCOMP_SIMD_SSE && defined(__AVX__)
+    __m256 v;
+
+    static float8 load(const float* p)  { return { _mm256_loadu_ps(p) }; }
+    void store(float* p) const          { _mm256_storeu_ps(p, v); }
+    // {a a}
+    static float8 dup(float4 a)         { return { _mm256_set_m128(a.v, a.v) }; }
+    // {x x x x y y y y}
+    static float8 broadcast(float x, float y)
+    {
+        return { _mm256_set_m128(_mm_set1_ps(y), _mm_set1_ps(x)) };
+    }
+
+    friend float8 operator+(float8 a, float8 b) { return { _mm256_add_ps(a.v, b.v) }; }
+    friend float8 operator-(float8 a, float8 b) { return { _mm256_sub_ps(a.v, b.v) }; }
+    friend float8 operator*(float8 a, float8 b) { return { _mm256_mul_ps(a.v, b.v) }; }
+
+    static float8 mulAdd(float8 a, float8 b, float8 c)
+    {
+     #if defined(__FMA__) || defined(__AVX2__)
+        return { _mm256_fmadd_ps(a.v, b.v, c.v) };
+     #else
+        return { _mm256_add_ps(_mm256_mul_ps(a.v, b.v), c.v) };
+     #endif
+    }
+#else
+    float4 lo, hi;
+
+    static float8 load(const float* p)  { return { float4::load(p), float4::load(p + 4) }; }
+    void store(float* p) const          { lo.store(p); hi.store(p + 4); }
+    static float8 dup(float4 a)         { return { a, a }; }
+    static float8 broadcast(float x, float y)
+    {
+        return { float4::broadcast(x), float4::broadcast(y) };
+    }
+
+    friend float8 operator+(float8 a, float8 b) { return { a.lo + b.lo, a.hi + b.hi }; }
+    friend float8 operator-(float8 a, float8 b) { return { a.lo - b.lo, a.hi - b.hi }; }
+    friend float8 operator*(float8 a, float8 b) { return { a.lo * b.lo, a.hi * b.hi }; }
+
+    static float8 mulAdd(float8 a, float8 b, float8 c)
+    {
+        return { float4::mulAdd(a.lo, b.lo, c.lo), float4::mulAdd(a.hi, b.hi, c.hi) };
+    }
+#endif
+};
@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    SharedContext.h
+    Created: 19 Oct 2026 11:58:02pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#define SHARED_WORKERS   2      // threads of the shared worker pool
+
+#include <juce_core/juce_core.h>
+#include <juce_dsp/juce_dsp.h>
+#include <memory>
+#include "TruePeakLimiter.h"
+#include "SpectralCompressor.h"
+
+// Resources of the process, shared by every plugin instance: the true peak
+// interpolator, the FFT plans and windows of every spectral order, and one
+// pool of worker threads for background jobs. Held through
+// juce::SharedResourcePointer, the first processor builds it and the last
+// one destroys it.
+// The tables are built in the constructor and never written again, so any
+// thread may read them without locking.
+class SharedContext {
+public:
+    //==================================================================
+    SharedContext() : workers(SHARED_WORKERS)
+    {
+        TruePeakLimiter::designInterpolator(interpolator);
+
+        for (int order = SPEC_MIN_ORDER; order <= SPEC_MAX_ORDER; order++)
+        {
+            const int k = order - SPEC_MIN_ORDER;
+            ffts[k] = std::make_unique<juce::dsp::FFT>(order);
+            windows[k] = new float[1 << order];
+            SpectralCompressor::designWindow(windows[k], 1 << order);
+        }
+    }
+    ~SharedContext()
+    {
+        // the owners of the jobs are gone by now, anything left is stopped
+        workers.removeAllJobs(true, 1000);
+
+        for (int k = 0; k <= SPEC_MAX_ORDER - SPEC_MIN_ORDER; k++)
+            delete[] windows[k];
+    }
+    SharedContext(const SharedContext&) = delete;
+    SharedContext& operator=(const SharedContext&) = delete;
+    //==================================================================
+    const float (*getInterpolator() const)[TP_PHASES]
+    {
+        return interpolator;
+    }
+    // order in SPEC_MIN_ORDER..SPEC_MAX_ORDER
+    const juce::dsp::FFT* getFFT(int order) const
+    {
+        return ffts[order - SPEC_MIN_ORDER].get();
+    }
+    const float* getWindow(int order) const
+    {
+        return windows[order - SPEC_MIN_ORDER];
+    }
+    // Background work of all instances (display renders, analysis), never
+    // the audio thread. Jobs must not outlive their owner: remove them
+    // before it goes.
+    juce::ThreadPool& getWorkers()
+    {
+        return workers;
+    }
+
+private:
+    //==================================================================
+    float interpolator[TP_TAPS][TP_PHASES];
+    std::unique_ptr<juce::dsp::FFT> ffts[SPEC_MAX_ORDER - SPEC_MIN_ORDER + 1];
+    float* windows[SPEC_MAX_ORDER - SPEC_MIN_ORDER + 1];
+
+    juce::ThreadPool workers;
+};
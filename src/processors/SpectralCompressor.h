@@ -0,0 +1,455 @@
+/*
+  ==============================================================================
+
+    SpectralCompressor.h
+    Created: 19 Oct 2026 4:55:17pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#define _USE_MATH_DEFINES
+
+#define SPEC_MIN_ORDER   10
+#define SPEC_MAX_ORDER   12
+#define SPEC_MAX_SIZE    (1 << SPEC_MAX_ORDER)
+#define SPEC_MIN_BANDS   16
+#define SPEC_MAX_BANDS   64
+#define SPEC_LOW_EDGE    20.0f      // [Hz]
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+#include <cmath>
+#include <memory>
+#include "FastMath.h"
+#include "Kernels.h"
+#include "defines.h"
+
+// Multiband dynamics on an overlap-add STFT (sqrt Hann, 75% overlap).
+// Bins are grouped into 16..64 bands evenly spaced on the ERB scale. Every
+// band gets its own gain computer at frame rate, the settings come from the
+// LOW / MID / HHI parameters interpolated over log frequency (the bands are
+// anchored at the middle of their range, f0 and f1 are the crossovers).
+// All buffers are members, nothing is allocated outside prepare(). The FFT
+// plan and the window are read-only and may be shared between instances.
+class SpectralCompressor {
+public:
+    //==================================================================
+    SpectralCompressor() :
+        f0(nullptr), f1(nullptr), bands(nullptr), stale(true),
+        fs(0), order(SPEC_MIN_ORDER), size(1 << SPEC_MIN_ORDER), hop(size / 4),
+        count(0), fft(nullptr), window(nullptr), ownWindow(nullptr),
+        numBands(0), grms(1), kernel(&kernels::get())
+    {
+        for (int band = 0; band < 3; band++)
+            at[band] = rt[band] = CT[band] = CR[band] = pre[band] = post[band] = nullptr;
+    }
+    ~SpectralCompressor()
+    {
+        delete[] ownWindow;
+    }
+    //==================================================================
+    // The plan and the window of orderFor(sampleRate) come from the caller
+    // when given (see SharedContext), otherwise the instance builds its own.
+    void prepare(double sampleRate, const juce::dsp::FFT* sharedFFT = nullptr, const float* sharedWindow = nullptr)
+    {
+        if (sampleRate < 0) throw("negative sample rate");
+
+        fs = sampleRate;
+        order = orderFor(fs);
+        size = 1 << order;
+        hop = size / 4;
+
+        ownFFT.reset();
+        delete[] ownWindow;
+        ownWindow = nullptr;
+        fft = sharedFFT;
+        window = sharedWindow;
+        if (fft == nullptr)
+        {
+            ownFFT = std::make_unique<juce::dsp::FFT>(order);
+            fft = ownFFT.get();
+        }
+        if (window == nullptr)
+        {
+            ownWindow = new float[size];
+            designWindow(ownWindow, size);
+            window = ownWindow;
+        }
+
+        numBands = 0;   // remap on the next frame
+        stale = true;
+        reset();
+    }
+    void reset()
+    {
+        for (int n = 0; n < size; n++)
+        {
+            input[n] = 0;
+            output[n] = 0;
+        }
+        for (int n = 0; n < hop; n++)
+            queue[n] = 0;
+        for (int band = 0; band < SPEC_MAX_BANDS; band++)
+            g[band] = 1;
+        for (int region = 0; region < 3; region++)
+        {
+            regionGain[region] = 1;
+            regionIn[region] = regionOut[region] = 0;
+        }
+        count = 0;
+    }
+    // in place, delayed by getLatency()
+    void process(float* data, int BufferSize)
+    {
+        float gsum = 0;
+        int frames = 0;
+
+        for (int i = 0; i < BufferSize; i++)
+        {
+            input[size - hop + count] = data[i];
+            data[i] = queue[count];
+
+            if (++count == hop)
+            {
+                processFrame();
+                count = 0;
+
+                for (int band = 0; band < numBands; band++)
+                    gsum += g[band] * g[band];
+                frames++;
+            }
+        }
+
+        if (frames > 0 && numBands > 0)
+            grms = std::sqrt(gsum / (frames * numBands));
+    }
+    //==================================================================
+    // FFT order at `sampleRate`: the bin spacing stays about the same at
+    // high sample rates
+    static int orderFor(double sampleRate)
+    {
+        int o = SPEC_MIN_ORDER;
+        while (o < SPEC_MAX_ORDER && sampleRate / (1 << o) > 64)
+            o++;
+        return o;
+    }
+    // sqrt Hann analysis and synthesis window of `length` samples
+    static void designWindow(float* w, int length)
+    {
+        for (int n = 0; n < length; n++)
+            w[n] = (float)std::sqrt(0.5 - 0.5 * std::cos(2 * M_PI * n / length));
+    }
+    //==================================================================
+    int getLatency() const
+    {
+        return size;
+    }
+    float getGRMS() const
+    {
+        return grms;
+    }
+    // mean gain of the bands in the LOW, MID or HHI range
+    float getRegionGain(int region) const
+    {
+        return regionGain[region];
+    }
+    // RMS level of the range in the last frame, after the pre gain, before
+    // and after the band gains (post gain not included), as the band meters
+    // of the crossover mode read
+    float getRegionInput(int region) const
+    {
+        return regionIn[region];
+    }
+    float getRegionOutput(int region) const
+    {
+        return regionOut[region];
+    }
+    //==================================================================
+    void setBandParameters(int band,
+        const float* at_ptr, const float* rt_ptr,
+        const float* CT_ptr, const float* CR_ptr,
+        const float* pre_ptr, const float* post_ptr)
+    {
+        at[band] = at_ptr;
+        rt[band] = rt_ptr;
+        CT[band] = CT_ptr;
+        CR[band] = CR_ptr;
+        pre[band] = pre_ptr;
+        post[band] = post_ptr;
+    }
+    void setf0(const float* param_ptr)
+    {
+        f0 = param_ptr;
+    }
+    void setf1(const float* param_ptr)
+    {
+        f1 = param_ptr;
+    }
+    void setbands(const float* param_ptr)
+    {
+        bands = param_ptr;
+    }
+
+private:
+    //==================================================================
+    void processFrame()
+    {
+        // analysis
+        for (int n = 0; n < size; n++)
+            spectrum[n] = input[n] * window[n];
+        for (int n = size; n < 2 * size; n++)
+            spectrum[n] = 0;
+        fft->performRealOnlyForwardTransform(spectrum);
+
+        // gain per band, then per bin
+        int wanted = bands != nullptr ? juce::jlimit(SPEC_MIN_BANDS, SPEC_MAX_BANDS, (int)*bands) : 32;
+        if (wanted != numBands)
+            mapBands(wanted);
+        if (settingsChanged())
+            updateSettings();
+
+        kernel->powerSpectrum(spectrum, power, size / 2 + 1);
+        computeGains();
+        kernel->spectralGain(spectrum, binGain, size);
+
+        // synthesis, sqrt Hann twice at 75% overlap sums to 2
+        fft->performRealOnlyInverseTransform(spectrum);
+        for (int n = 0; n < size; n++)
+            output[n] += 0.5f * spectrum[n] * window[n];
+
+        // hand over the finished hop, slide both buffers
+        for (int n = 0; n < hop; n++)
+            queue[n] = output[n];
+        for (int n = 0; n < size - hop; n++)
+        {
+            output[n] = output[n + hop];
+            input[n] = input[n + hop];
+        }
+        for (int n = size - hop; n < size; n++)
+            output[n] = 0;
+    }
+    //==================================================================
+    // Band edges evenly spaced on the ERB-rate scale, at least one bin wide.
+    void mapBands(int wanted)
+    {
+        numBands = wanted;
+        stale = true;
+        const int bins = size / 2 + 1;
+        const double binHz = fs / size;
+        const double eLow = erbRate(SPEC_LOW_EDGE);
+        const double eHigh = erbRate(fs / 2);
+
+        edge[0] = 0;
+        for (int band = 1; band < numBands; band++)
+        {
+            double f = erbToHz(eLow + band * (eHigh - eLow) / numBands);
+            int k = (int)std::round(f / binHz);
+            edge[band] = juce::jlimit(edge[band - 1] + 1, bins - (numBands - band), k);
+        }
+        edge[numBands] = bins;
+
+        for (int band = 0; band < numBands; band++)
+            center[band] = 0.5f * (edge[band] + edge[band + 1] - 1);
+
+        // every bin interpolates between the two nearest band centers
+        int band = 0;
+        for (int k = 0; k < bins; k++)
+        {
+            while (band < numBands - 2 && k > center[band + 1])
+                band++;
+            float frac = (k - center[band]) / (center[band + 1] - center[band]);
+            if (numBands < 2) frac = 0;
+            binBand[k] = band;
+            binFrac[k] = juce::jlimit(0.0f, 1.0f, frac);
+        }
+    }
+    // True when an input of updateSettings() moved since the last call.
+    bool settingsChanged()
+    {
+        bool changed = stale;
+        int k = 0;
+        auto check = [&](const float* p)
+        {
+            const float v = p != nullptr ? *p : 0;
+            changed = changed || v != lastSettings[k];
+            lastSettings[k++] = v;
+        };
+        for (int band = 0; band < 3; band++)
+        {
+            check(at[band]); check(rt[band]); check(CT[band]);
+            check(CR[band]); check(pre[band]); check(post[band]);
+        }
+        check(f0);
+        check(f1);
+
+        stale = false;
+        return changed;
+    }
+    // Interpolates the three band settings over log frequency.
+    void updateSettings()
+    {
+        const float lowEdge = SPEC_LOW_EDGE;
+        const float split0 = f0 != nullptr ? *f0 : deff0;
+        const float split1 = f1 != nullptr ? juce::jmax(*f1, split0) : deff1;
+        const float anchor[3] = {
+            std::log(std::sqrt(lowEdge * split0)),
+            std::log(std::sqrt(split0 * split1)),
+            std::log(std::sqrt(split1 * (float)fs / 2)),
+        };
+        const double binHz = fs / size;
+        const double frame = (double)hop / fs * 1000;   // [ms]
+
+        for (int band = 0; band < numBands; band++)
+        {
+            float lf = std::log(juce::jmax(lowEdge, (float)(center[band] * binHz)));
+            int r = lf < anchor[1] ? 0 : 1;
+            float u = juce::jlimit(0.0f, 1.0f, (lf - anchor[r]) / (anchor[r + 1] - anchor[r]));
+            if (!(anchor[r + 1] > anchor[r])) u = 0;
+
+            auto lerp = [&](const float* const* p)
+                { return (1 - u) * *p[r] + u * *p[r + 1]; };
+            auto loglerp = [&](const float* const* p)
+                { return std::exp((1 - u) * std::log(*p[r]) + u * std::log(*p[r + 1])); };
+
+            threshold[band] = lerp(CT);
+            slope[band] = 1 - 1 / lerp(CR);
+            preDB[band] = lerp(pre);
+            makeup[band] = std::pow(10.0f, (lerp(pre) + lerp(post)) / 20);
+            prePower[band] = std::pow(10.0f, lerp(pre) / 10);
+            cat[band] = (float)(1 - std::exp(-2.2 * frame / loglerp(at)));
+            crt[band] = (float)(1 - std::exp(-2.2 * frame / loglerp(rt)));
+            region[band] = lf < std::log(split0) ? LOW : (lf < std::log(split1) ? MID : HHI);
+        }
+    }
+    void computeGains()
+    {
+        // positive bins hold half the energy: a sine of amplitude A reads A
+        const float norm = 8.0f / ((float)size * size);
+        float rsum[3] = { 0, 0, 0 };
+        int rcount[3] = { 0, 0, 0 };
+        float rin[3] = { 0, 0, 0 };
+        float rout[3] = { 0, 0, 0 };
+
+        for (int band = 0; band < numBands; band++)
+        {
+            float energy = 0;
+            for (int k = edge[band]; k < edge[band + 1]; k++)
+                energy += power[k];
+            level[band] = energy * norm;
+            bandPower[band] = level[band] * prePower[band];
+        }
+
+        // level -> gain target of every band, the conversions run four
+        // bands per vector
+        fastmath::fast_gain_to_db(level, level, numBands);
+        for (int band = 0; band < numBands; band++)
+        {
+            float X = 0.5f * level[band] + preDB[band];    // power: 10 log10
+            float G = slope[band] * (threshold[band] - X);
+            level[band] = G > 0 ? 0 : G;
+        }
+        fastmath::fast_db_to_gain(level, level, numBands);
+
+        for (int band = 0; band < numBands; band++)
+        {
+            float target = level[band];
+            if (target < g[band])
+                g[band] = (1 - cat[band]) * g[band] + cat[band] * target;
+            else
+                g[band] = (1 - crt[band]) * g[band] + crt[band] * target;
+
+            bandGain[band] = g[band] * makeup[band];
+            rsum[region[band]] += g[band];
+            rcount[region[band]]++;
+            rin[region[band]] += bandPower[band];
+            rout[region[band]] += bandPower[band] * g[band] * g[band];
+        }
+        // a sine of amplitude A reads A^2, its RMS is A / sqrt(2)
+        for (int r = 0; r < 3; r++)
+        {
+            regionGain[r] = rcount[r] > 0 ? rsum[r] / rcount[r] : 1;
+            regionIn[r] = std::sqrt(rin[r] / 2);
+            regionOut[r] = std::sqrt(rout[r] / 2);
+        }
+
+        const int bins = size / 2 + 1;
+        for (int k = 0; k < bins; k++)
+        {
+            int band = binBand[k];
+            float next = numBands > 1 ? bandGain[band + 1] : bandGain[band];
+            binGain[k] = bandGain[band] + (next - bandGain[band]) * binFrac[k];
+        }
+        // the negative frequencies mirror the positive ones
+        for (int k = bins; k < size; k++)
+            binGain[k] = binGain[size - k];
+    }
+    //==================================================================
+    static double erbRate(double f)
+    {
+        return 21.4 * std::log10(1 + 0.00437 * f);
+    }
+    static double erbToHz(double e)
+    {
+        return (std::pow(10.0, e / 21.4) - 1) / 0.00437;
+    }
+    //==================================================================
+    const float* at[3];
+    const float* rt[3];
+    const float* CT[3];
+    const float* CR[3];
+    const float* pre[3];
+    const float* post[3];
+    const float* f0;
+    const float* f1;
+    const float* bands;
+    float lastSettings[20];     // 6 per band, f0, f1
+    bool stale;                 // band layout or fs changed
+
+    double fs;
+    int order;
+    int size;
+    int hop;
+    int count;
+    const juce::dsp::FFT* fft;          // const, safe to share between threads
+    const float* window;
+    std::unique_ptr<juce::dsp::FFT> ownFFT; // when not shared
+    float* ownWindow;
+
+    // workspace
+    alignas(16) float input[SPEC_MAX_SIZE];
+    alignas(16) float output[SPEC_MAX_SIZE];
+    alignas(16) float queue[SPEC_MAX_SIZE / 4];
+    alignas(16) float spectrum[2 * SPEC_MAX_SIZE];
+    alignas(16) float power[SPEC_MAX_SIZE / 2 + 4];
+    alignas(16) float binGain[SPEC_MAX_SIZE];
+
+    // bands
+    int numBands;
+    int edge[SPEC_MAX_BANDS + 1];
+    float center[SPEC_MAX_BANDS];
+    int binBand[SPEC_MAX_SIZE / 2 + 1];
+    float binFrac[SPEC_MAX_SIZE / 2 + 1];
+
+    float threshold[SPEC_MAX_BANDS];
+    float slope[SPEC_MAX_BANDS];
+    float preDB[SPEC_MAX_BANDS];
+    float makeup[SPEC_MAX_BANDS];
+    float prePower[SPEC_MAX_BANDS];     // pre gain, squared
+    float bandPower[SPEC_MAX_BANDS];    // input level after the pre gain
+    float cat[SPEC_MAX_BANDS];
+    float crt[SPEC_MAX_BANDS];
+    int region[SPEC_MAX_BANDS];
+    float g[SPEC_MAX_BANDS];
+    float bandGain[SPEC_MAX_BANDS];
+    alignas(16) float level[SPEC_MAX_BANDS];
+
+    float regionGain[3];
+    float regionIn[3];
+    float regionOut[3];
+    float grms;
+
+    const KernelTable* kernel;
+};
@@ -0,0 +1,295 @@
+/*
+  ==============================================================================
+
+    TruePeakLimiter.h
+    Created: 19 Oct 2026 1:26:52pm
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#define _USE_MATH_DEFINES
+
+#define TP_LOOKAHEAD     1.5    // [ms]
+#define TP_RELEASE_TIME  80     // [ms]
+#define TP_PHASES        4      // oversampling factor of the peak detector
+#define TP_TAPS          12     // interpolator taps per phase
+#define TP_BLOCK         64     // samples per detection / gain pass
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <cmath>
+#include "CircularBuffer.h"
+#include "SlidingMax.h"
+#include "Arena.h"
+#include "Kernels.h"
+
+// Brickwall limiter on inter-sample (true) peaks.
+// The peak of every sample is estimated by a 4x polyphase interpolator, the
+// gain needed to keep it under the ceiling is held for the lookahead window
+// (sliding maximum of the peaks) and smoothed by a moving average of the same
+// length, so the gain has fully ramped down by the time the peak leaves the
+// delay line. Gain is linked across channels.
+// Mono and stereo run a block pass specialized on the channel count (picked
+// in prepare()), stereo keeps the detector history of both channels
+// interleaved; other layouts take the generic pass.
+class TruePeakLimiter {
+public:
+    //==================================================================
+    TruePeakLimiter() :
+        ceiling(nullptr), lastCeiling(-1000), ceilLin(1), rel(1), numChannels(0), fs(0), lookahead(2),
+        taps(nullptr), ownTaps(nullptr), hist(nullptr), histPos(0), delays(nullptr), ownsState(true),
+        env(1), gsum(0), active(false), grms(0), kernel(&kernels::get()),
+        block(&TruePeakLimiter::processBlock<0>)
+    {
+    }
+    ~TruePeakLimiter()
+    {
+        freeState();
+        delete[] ownTaps;
+    }
+    //==================================================================
+    // The history, the delay lines and the envelope state come from
+    // `arena` when given, see getArenaBytes().
+    void prepare(double sampleRate, int channels, Arena* arena = nullptr)
+    {
+        if (sampleRate < 0) throw("negative sample rate");
+        if (channels < 0) throw("negative channel count");
+
+        fs = sampleRate;
+        numChannels = channels;
+        rel = 1 - std::exp(-2.2 / fs / TP_RELEASE_TIME * 1000);
+        lookahead = lookaheadFor(fs);
+        const int latency = getLatency();
+        if (taps == nullptr)
+        {
+            ownTaps = new float[TP_TAPS][TP_PHASES];
+            designInterpolator(ownTaps);
+            taps = ownTaps;
+        }
+
+        freeState();
+        ownsState = arena == nullptr;
+        if (arena != nullptr)
+        {
+            hist = arena->allocate<float>(numChannels * 2 * TP_TAPS);
+            delays = arena->create<CircularBuffer<float>>(numChannels);
+            for (int ch = 0; ch < numChannels; ch++)
+                delays[ch].setStorage(arena->allocate<float>(latency), latency);
+
+            peaks.setStorage(arena->allocate<float>(lookahead), arena->allocate<unsigned int>(lookahead), lookahead);
+            gains.setStorage(arena->allocate<float>(lookahead), lookahead);
+        }
+        else
+        {
+            hist = new float[numChannels * 2 * TP_TAPS];
+            delays = new CircularBuffer<float>[numChannels];
+            for (int ch = 0; ch < numChannels; ch++)
+                delays[ch].resize(latency);
+
+            peaks.resize(lookahead);
+            gains.resize(lookahead);
+        }
+
+        block = numChannels == 1 ? &TruePeakLimiter::processBlock<1>
+              : numChannels == 2 ? &TruePeakLimiter::processBlock<2>
+              : &TruePeakLimiter::processBlock<0>;
+
+        reset();
+    }
+    void reset()
+    {
+        for (int i = 0; i < numChannels * 2 * TP_TAPS; i++)
+            hist[i] = 0;
+        histPos = 0;
+
+        peaks.clear();
+        for (int i = 0; i < lookahead; i++)
+            gains.push(1);
+        gsum = lookahead;
+        env = 1;
+    }
+    // When limit is false the audio only runs through the delay line, so
+    // the reported latency does not depend on the switch.
+    void process(float* const* channels, int BufferSize, bool limit)
+    {
+        if (limit && !active)
+            reset();
+        active = limit;
+        grms = 0;
+
+        if (*ceiling != lastCeiling)
+        {
+            ceilLin = std::pow(10, *ceiling / 20);
+            lastCeiling = *ceiling;
+        }
+
+        for (int start = 0; start < BufferSize; start += TP_BLOCK)
+            (this->*block)(channels, start, juce::jmin(TP_BLOCK, BufferSize - start), limit);
+
+        grms = limit && BufferSize > 0 ? std::sqrt(grms / BufferSize) : 1;
+    }
+    //==================================================================
+    // Phase 0 of the interpolator is x[n - TP_TAPS / 2], so sample m first
+    // reaches the detector at m + TP_TAPS / 2. The sliding max and the
+    // moving average (both `lookahead` long) reach the full gain for it
+    // lookahead - 1 samples later: the delay is lookahead + TP_TAPS / 2 - 1.
+    int getLatency() const
+    {
+        return delayFor(lookahead);
+    }
+    static size_t getArenaBytes(double sampleRate, int channels)
+    {
+        const int n = lookaheadFor(sampleRate);
+        return Arena::bytes<float>(channels * 2 * TP_TAPS)
+            + Arena::bytes<CircularBuffer<float>>(channels)
+            + channels * Arena::bytes<float>(delayFor(n))
+            + Arena::bytes<float>(n) + Arena::bytes<unsigned int>(n) + Arena::bytes<float>(n);
+    }
+    float getGRMS() const
+    {
+        return grms;
+    }
+    //==================================================================
+    void setceiling(const float* param_ptr)
+    {
+        ceiling = param_ptr;
+    }
+    // TP_TAPS x TP_PHASES table of designInterpolator(), read only, for
+    // instances sharing one (see SharedContext); set before prepare()
+    void setInterpolator(const float (*table)[TP_PHASES])
+    {
+        taps = table;
+    }
+    //==================================================================
+    // Windowed sinc at the original Nyquist frequency. Phase 0 has a single
+    // nonzero tap, so the sample peak itself is always part of the estimate.
+    // taps[j] holds tap j of all four phases, the detector kernel computes
+    // every phase of an output sample in one vector.
+    static void designInterpolator(float (*taps)[TP_PHASES])
+    {
+        const int length = TP_PHASES * TP_TAPS;
+        const int center = length / 2;
+
+        for (int p = 0; p < TP_PHASES; p++)
+        {
+            float sum = 0;
+            for (int j = 0; j < TP_TAPS; j++)
+            {
+                int k = TP_PHASES * j + p;
+                double t = (double)(k - center) / TP_PHASES;
+                double sinc = (k == center) ? 1.0 : ((k - center) % TP_PHASES == 0 ? 0.0 : std::sin(M_PI * t) / (M_PI * t));
+                double w = 0.42 - 0.5 * std::cos(2 * M_PI * k / length) + 0.08 * std::cos(4 * M_PI * k / length);
+                taps[j][p] = (float)(sinc * w);
+                sum += taps[j][p];
+            }
+            for (int j = 0; j < TP_TAPS; j++)
+                taps[j][p] /= sum;
+        }
+    }
+
+private:
+    //==================================================================
+    static int lookaheadFor(double sampleRate)
+    {
+        return juce::jmax(2, (int)std::ceil(TP_LOOKAHEAD * sampleRate / 1000));
+    }
+    // see getLatency()
+    static int delayFor(int lookahead)
+    {
+        return lookahead + TP_TAPS / 2 - 1;
+    }
+    void freeState()
+    {
+        if (ownsState)
+        {
+            delete[] hist;
+            delete[] delays;
+        }
+        hist = nullptr;
+        delays = nullptr;
+    }
+    //==================================================================
+    // One TP_BLOCK pass. NumChannels is 1 or 2 for the specialized passes
+    // (fixed trip counts, the channel loops unroll), 0 for any layout.
+    template <int NumChannels>
+    void processBlock(float* const* channels, int start, int n, bool limit)
+    {
+        const int nch = NumChannels > 0 ? NumChannels : numChannels;
+
+        if (!limit)
+        {
+            for (int i = 0; i < n; i++)
+                for (int ch = 0; ch < nch; ch++)
+                    channels[ch][start + i] = delays[ch].push(channels[ch][start + i]);
+            return;
+        }
+
+        // detection, peak of all channels
+        for (int i = 0; i < n; i++)
+            peak[i] = 0;
+        if constexpr (NumChannels == 2)
+        {
+            const float* in[2] = { channels[0] + start, channels[1] + start };
+            histPos = kernel->truePeakStereo(in, hist, histPos, n, taps, TP_TAPS, peak);
+        }
+        else
+        {
+            int pos = histPos;
+            for (int ch = 0; ch < nch; ch++)
+                pos = kernel->truePeak(channels[ch] + start, hist + ch * 2 * TP_TAPS, histPos, n, taps, TP_TAPS, peak);
+            histPos = pos;
+        }
+
+        // gain envelope
+        for (int i = 0; i < n; i++)
+        {
+            float held = peaks.push(peak[i]);
+            float target = held > ceilLin ? ceilLin / held : 1.0f;
+
+            if (target < env)
+                env = target;               // instant, the lookahead does the ramp
+            else
+                env += rel * (target - env);
+
+            gsum += env - gains.push(env);
+            gain[i] = (float)(gsum / lookahead);
+            grms += gain[i] * gain[i];
+        }
+
+        // apply on the delayed signal
+        for (int i = 0; i < n; i++)
+            for (int ch = 0; ch < nch; ch++)
+                channels[ch][start + i] = gain[i] * delays[ch].push(channels[ch][start + i]);
+    }
+    //==================================================================
+    const float* ceiling;
+    float lastCeiling;
+    float ceilLin;                      // linear ceiling, follows *ceiling
+    float rel;                          // release coefficient, follows fs
+
+    int numChannels;
+    double fs;
+    int lookahead;
+
+    const float (*taps)[TP_PHASES];     // interpolator, shared or ownTaps
+    float (*ownTaps)[TP_PHASES];
+    float* hist;                        // 2 * TP_TAPS per channel, interleaved in stereo
+    int histPos;
+    CircularBuffer<float>* delays;
+    bool ownsState;                     // hist and delays are not in an arena
+
+    SlidingMax<float> peaks;
+    CircularBuffer<float> gains;
+    float peak[TP_BLOCK];
+    float gain[TP_BLOCK];
+    float env;
+    double gsum;
+    bool active;
+
+    float grms;
+
+    const KernelTable* kernel;
+    void (TruePeakLimiter::*block)(float* const*, int, int, bool);
+};
@@ -0,0 +1,132 @@
+/*
+  ==============================================================================
+
+    Loudness.h
+    Created: 20 Oct 2026 3:02:37am
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#define _USE_MATH_DEFINES
+
+#define LOUDNESS_BLOCK      400     // [ms] gating block
+#define LOUDNESS_STEP       100     // [ms] gating block hop, 75% overlap
+#define LOUDNESS_ABS_GATE   -70.0   // [LUFS]
+#define LOUDNESS_REL_GATE   -10.0   // [LU] below the absolute gated loudness
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// Integrated loudness after ITU-R BS.1770-4: K-weighting (high shelf and
+// high pass, coefficients for any sample rate), mean square per channel
+// summed with weight 1 (mono and stereo only), 400 ms blocks gated at
+// -70 LUFS and at 10 LU below the loudness of the blocks above that.
+// Fed in any piece size, the file does not have to be in memory.
+class LoudnessMeter {
+public:
+    //==================================================================
+    void prepare(double sampleRate, int numChannels)
+    {
+        fs = sampleRate;
+        channels = numChannels;
+        stepLength = (int)(LOUDNESS_STEP * fs / 1000);
+
+        // high shelf, +4 dB above ~1.7 kHz
+        double K = std::tan(M_PI * 1681.974450955533 / fs);
+        double Q = 0.7071752369554196;
+        double Vh = std::pow(10.0, 3.999843853973347 / 20);
+        double Vb = std::pow(Vh, 0.4996667741545416);
+        double a0 = 1 + K / Q + K * K;
+        shelf = { (Vh + Vb * K / Q + K * K) / a0, 2 * (K * K - Vh) / a0, (Vh - Vb * K / Q + K * K) / a0,
+                  2 * (K * K - 1) / a0, (1 - K / Q + K * K) / a0 };
+
+        // high pass at ~38 Hz
+        K = std::tan(M_PI * 38.13547087602444 / fs);
+        Q = 0.5003270373238773;
+        a0 = 1 + K / Q + K * K;
+        highpass = { 1, -2, 1, 2 * (K * K - 1) / a0, (1 - K / Q + K * K) / a0 };
+
+        std::fill(&state[0][0][0], &state[0][0][0] + 8, 0.0);
+        stepSum = 0;
+        stepFill = 0;
+        steps.clear();
+    }
+    void process(const float* const* data, int n)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            for (int ch = 0; ch < channels; ch++)
+            {
+                const double y = highpass.run(shelf.run(data[ch][i], state[ch][0]), state[ch][1]);
+                stepSum += y * y;
+            }
+            if (++stepFill == stepLength)
+            {
+                steps.push_back(stepSum / stepLength);
+                stepSum = 0;
+                stepFill = 0;
+            }
+        }
+    }
+    // [LUFS], -inf if no block passes the gates
+    double getIntegrated() const
+    {
+        const int perBlock = LOUDNESS_BLOCK / LOUDNESS_STEP;
+        std::vector<double> blocks;
+        for (size_t k = 0; k + perBlock <= steps.size(); k++)
+        {
+            double z = 0;
+            for (int j = 0; j < perBlock; j++)
+                z += steps[k + j];
+            blocks.push_back(z / perBlock);
+        }
+
+        auto gated = [&blocks](double gate)
+            {
+                double sum = 0;
+                int count = 0;
+                for (double z : blocks)
+                    if (loudnessOf(z) > gate)
+                    {
+                        sum += z;
+                        count++;
+                    }
+                return count > 0 ? loudnessOf(sum / count) : -std::numeric_limits<double>::infinity();
+            };
+        return gated(std::max(LOUDNESS_ABS_GATE, gated(LOUDNESS_ABS_GATE) + LOUDNESS_REL_GATE));
+    }
+
+private:
+    //==================================================================
+    struct Biquad {
+        double b0, b1, b2, a1, a2;
+
+        // transposed direct form II, s: two state values
+        double run(double x, double* s) const
+        {
+            const double y = b0 * x + s[0];
+            s[0] = b1 * x - a1 * y + s[1];
+            s[1] = b2 * x - a2 * y;
+            return y;
+        }
+    };
+    static double loudnessOf(double meanSquare)
+    {
+        return meanSquare > 0 ? -0.691 + 10 * std::log10(meanSquare) : -std::numeric_limits<double>::infinity();
+    }
+    //==================================================================
+    double fs = 48000;
+    int channels = 0;
+    Biquad shelf{}, highpass{};
+    double state[2][2][2];  // channel, stage, biquad state
+
+    int stepLength = 0;
+    double stepSum = 0;     // weighted square sum of the current 100 ms
+    int stepFill = 0;
+    std::vector<double> steps;  // mean squares of every 100 ms step
+};
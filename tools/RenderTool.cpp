@@ -0,0 +1,244 @@
+/*
+  ==============================================================================
+
+    RenderTool.cpp
+    Created: 20 Oct 2026 2:24:05am
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#define RENDER_BLOCK        512     // processBlock size of every instance
+#define RENDER_ALIGN        4096    // grid of the segments and warm-ups, see below
+#define RENDER_TOLERANCE    1e-5f   // -100 dBFS, largest seam error --verify accepts
+
+#include <cstdio>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "Tools.h"
+#include "PluginProcessor.h"
+
+// Parallel offline render of one long file. The file is cut into segments,
+// every segment goes through its own fresh instance, on as many threads as
+// asked for, and lands at its place in one output buffer.
+// A fresh instance does not start from the state the serial render has at
+// the segment start, so it is fed getSettleSamples() of the input before
+// the segment (the warm-up) and that output is thrown away: by the segment
+// start every filter, envelope and delay line depends on the input only.
+// The DSP also has periodic schedules counted from the first sample (the
+// control rate of the gain computers, decimation, STFT hops, the blocks of
+// the limiter). They are all powers of two up to SPEC_MAX_SIZE, so warm-ups
+// start on a RENDER_ALIGN grid and every instance is fed blocks of
+// RENDER_BLOCK from there: the schedules line up with the serial render.
+// The instances run non-realtime, where the processor does not skip idle
+// input: the skip holds the schedules still, for a number of blocks that
+// depends on where the instance started.
+namespace
+{
+    static_assert(RENDER_ALIGN % SPEC_MAX_SIZE == 0 && RENDER_ALIGN % RENDER_BLOCK == 0);
+
+    struct Segment {
+        int from;           // warm-up start
+        int start, end;     // kept output
+    };
+
+    int alignUp(int samples)
+    {
+        return (samples + RENDER_ALIGN - 1) / RENDER_ALIGN * RENDER_ALIGN;
+    }
+
+    std::unique_ptr<MBComp01AudioProcessor> createInstance(const juce::MemoryBlock& state, int channels, double fs)
+    {
+        auto processor = std::make_unique<MBComp01AudioProcessor>();
+        processor->setPlayConfigDetails(channels, channels, fs, RENDER_BLOCK);
+        processor->setNonRealtime(true);
+        // before prepareToPlay: the preset is taken at once, no fade in
+        if (state.getSize() > 0)
+            processor->setStateInformation(state.getData(), (int)state.getSize());
+        processor->prepareToPlay(fs, RENDER_BLOCK);
+        return processor;
+    }
+
+    // Input [from, end + latency) through a fresh instance, zeros past the
+    // end of the file; output [start, end) in place, latency removed.
+    void renderSegment(const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& output,
+                       const juce::MemoryBlock& state, double fs, const Segment& s)
+    {
+        const int channels = input.getNumChannels();
+        auto processor = createInstance(state, channels, fs);
+        const int latency = processor->getLatencySamples();
+
+        juce::AudioBuffer<float> block(channels, RENDER_BLOCK);
+        juce::MidiBuffer midi;
+        for (int pos = s.from; pos < s.end + latency; pos += RENDER_BLOCK)
+        {
+            const int n = juce::jmin(RENDER_BLOCK, s.end + latency - pos);
+            juce::AudioBuffer<float> piece(block.getArrayOfWritePointers(), channels, n);
+            fillPiece(input, piece, pos);
+
+            processor->processBlock(piece, midi);
+
+            const int first = juce::jmax(s.start, pos - latency);
+            const int last = juce::jmin(s.end, pos + n - latency);
+            for (int ch = 0; ch < channels && first < last; ch++)
+                output.copyFrom(ch, first, piece, ch, first - (pos - latency), last - first);
+        }
+    }
+
+    // segments taken by the threads in order, as they get free
+    double renderParallel(const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& output,
+                          const juce::MemoryBlock& state, double fs, const std::vector<Segment>& segments, int threads)
+    {
+        const auto start = juce::Time::getHighResolutionTicks();
+        std::atomic<int> next{ 0 };
+        auto work = [&]
+            {
+                for (int k = next++; k < (int)segments.size(); k = next++)
+                    renderSegment(input, output, state, fs, segments[k]);
+            };
+
+        std::vector<std::thread> workers;
+        for (int t = 1; t < threads; t++)
+            workers.emplace_back(work);
+        work();
+        for (auto& worker : workers)
+            worker.join();
+        return secondsSince(start);
+    }
+
+    std::vector<Segment> plan(int length, int segmentLength, int warmup)
+    {
+        std::vector<Segment> segments;
+        for (int start = 0; start < length; start += segmentLength)
+            segments.push_back({ juce::jmax(0, start - warmup), start, juce::jmin(length, start + segmentLength) });
+        return segments;
+    }
+
+    // largest difference inside every segment, the seams are at their
+    // starts; 1 if the worst is above RENDER_TOLERANCE
+    int report(const char* what, const juce::AudioBuffer<float>& parallel, const juce::AudioBuffer<float>& serial,
+               const std::vector<Segment>& segments, double fs)
+    {
+        double worst = 0;
+        int seam = 0;
+        for (const auto& s : segments)
+            for (int ch = 0; ch < serial.getNumChannels(); ch++)
+            {
+                const float* x = parallel.getReadPointer(ch);
+                const float* y = serial.getReadPointer(ch);
+                for (int i = s.start; i < s.end; i++)
+                    if (std::abs(x[i] - y[i]) > worst)
+                    {
+                        worst = std::abs(x[i] - y[i]);
+                        seam = s.start;
+                    }
+            }
+
+        std::printf("%s: max error against the serial render %.2e (%.1f dBFS), worst seam at %.2f s\n",
+            what, worst, toDecibels(worst), seam / fs);
+        return worst <= RENDER_TOLERANCE ? 0 : 1;
+    }
+}
+
+int runRenderTool(const juce::StringArray& args)
+{
+    if (args.size() < 2)
+    {
+        std::printf("render: input and output files expected\n");
+        return 1;
+    }
+
+    juce::AudioBuffer<float> input;
+    double fs = 0;
+    if (!readAudio(juce::File::getCurrentWorkingDirectory().getChildFile(args[0]), input, fs))
+    {
+        std::printf("render: can't read %s\n", args[0].toRawUTF8());
+        return 1;
+    }
+    if (input.getNumChannels() > 2)
+    {
+        std::printf("render: mono or stereo input expected, as the plugin takes\n");
+        return 1;
+    }
+    juce::MemoryBlock state;
+    const juce::String stateFile = optionValue(args, "--state");
+    if (stateFile.isNotEmpty() && !readState(juce::File::getCurrentWorkingDirectory().getChildFile(stateFile), state))
+    {
+        std::printf("render: can't read the state %s\n", stateFile.toRawUTF8());
+        return 1;
+    }
+
+    const int channels = input.getNumChannels();
+    const int length = input.getNumSamples();
+    const int cores = juce::jmax(1, (int)std::thread::hardware_concurrency());
+    const int threads = juce::jlimit(1, 256, optionValue(args, "--threads", juce::String(cores)).getIntValue());
+
+    // warm-up from the settings, segments long enough to keep it a small
+    // share of the work and short enough for a few per thread
+    const int warmup = alignUp(createInstance(state, channels, fs)->getSettleSamples());
+    const double segmentSeconds = optionValue(args, "--segment", "0").getDoubleValue();
+    const int segmentLength = alignUp(segmentSeconds > 0 ? (int)(segmentSeconds * fs)
+        : juce::jmax(8 * warmup, length / (4 * threads)));
+    const auto segments = plan(length, segmentLength, warmup);
+
+    std::printf("%d channels, %.1f s at %g Hz, %d segments of %.1f s, warm-up %.2f s (+%.1f%% work)\n",
+        channels, length / fs, fs, (int)segments.size(), segmentLength / fs, warmup / fs,
+        100.0 * (segments.size() - 1) * warmup / juce::jmax(1, length));
+
+    juce::AudioBuffer<float> output(channels, length);
+    const double wall = renderParallel(input, output, state, fs, segments, threads);
+    std::printf("%d threads: %.2f s, %.0fx realtime\n", threads, wall, length / fs / wall);
+
+    int result = 0;
+    if (hasOption(args, "--scaling"))
+    {
+        // same segments, so the work is the same at every thread count
+        juce::AudioBuffer<float> scratch(channels, length);
+        std::vector<int> counts;
+        for (int t = 1; t < cores; t *= 2)
+            counts.push_back(t);
+        counts.push_back(cores);
+
+        double single = 0;
+        std::printf("%8s %10s %12s %8s\n", "threads", "wall [s]", "x realtime", "speedup");
+        for (int t : counts)
+        {
+            const double time = renderParallel(input, scratch, state, fs, segments, t);
+            if (t == 1)
+                single = time;
+            std::printf("%8d %10.2f %12.0f %8.2f\n", t, time, length / fs / time, single / time);
+        }
+    }
+
+    if (hasOption(args, "--verify"))
+    {
+        juce::AudioBuffer<float> serial(channels, length);
+        const double time = renderParallel(input, serial, state, fs, { { 0, 0, length } }, 1);
+        std::printf("serial: %.2f s, speedup %.2f\n", time, time / wall);
+        result |= report("input", output, serial, segments, fs);
+
+        // The input again with a silent gap long enough for the idle skip,
+        // warm-ups starting inside it: offline, the skip must not move the
+        // schedules of one instance against the other.
+        const int gapStart = length / 4;
+        const int gapLength = juce::jmin(length / 2, 2 * (warmup + segmentLength));
+        juce::AudioBuffer<float> gapped(channels, length), parallel(channels, length);
+        for (int ch = 0; ch < channels; ch++)
+        {
+            gapped.copyFrom(ch, 0, input, ch, 0, length);
+            gapped.clear(ch, gapStart, gapLength);
+        }
+        renderParallel(gapped, parallel, state, fs, segments, threads);
+        renderParallel(gapped, serial, state, fs, { { 0, 0, length } }, 1);
+        const juce::String what = juce::String("silent ") + juce::String(gapLength / fs, 1) + " s";
+        result |= report(what.toRawUTF8(), parallel, serial, segments, fs);
+    }
+
+    if (!writeAudio(juce::File::getCurrentWorkingDirectory().getChildFile(args[1]), output, fs))
+    {
+        std::printf("render: can't write %s\n", args[1].toRawUTF8());
+        return 1;
+    }
+    return result;
+}
@@ -0,0 +1,309 @@
+/*
+  ==============================================================================
+
+    SweepTool.cpp
+    Created: 20 Oct 2026 3:18:50am
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#define SWEEP_BLOCK         512     // processBlock size of every instance
+#define SWEEP_ACTIVE_GR     1.0f    // [dB] gain reduction that counts as compressing
+#define SWEEP_MAX_RUNS      100000  // combinations in one sweep
+
+#include <cstdio>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Tools.h"
+#include "Loudness.h"
+#include "PluginProcessor.h"
+
+// Parameter sweep over one program. The input is decoded once and read by
+// every thread; each combination of the swept values runs through its own
+// instance and leaves a CSV row of metrics, no audio. Rows are written as
+// the combinations finish, so the order follows the threads: sort by index.
+// The band values (CT, CR, at, rt) go to every band of --bands at once.
+// Anything not swept keeps its value from --state, or the default.
+namespace
+{
+    const char* const bandNames[4] = { "low", "mid", "high", "master" };
+
+    const struct {
+        const char* name;   // option without the dashes, CSV column
+        juce::RangedAudioParameter* (*param)(MBComp01AudioProcessor&, int band);
+        bool perBand;
+    } axes[] =
+    {
+        { "CT", [](MBComp01AudioProcessor& p, int band) -> juce::RangedAudioParameter* { return p.getCT(band); }, true },
+        { "CR", [](MBComp01AudioProcessor& p, int band) -> juce::RangedAudioParameter* { return p.getCR(band); }, true },
+        { "at", [](MBComp01AudioProcessor& p, int band) -> juce::RangedAudioParameter* { return p.getat(band); }, true },
+        { "rt", [](MBComp01AudioProcessor& p, int band) -> juce::RangedAudioParameter* { return p.getrt(band); }, true },
+        { "f0", [](MBComp01AudioProcessor& p, int)      -> juce::RangedAudioParameter* { return p.getf0(); },     false },
+        { "f1", [](MBComp01AudioProcessor& p, int)      -> juce::RangedAudioParameter* { return p.getf1(); },     false },
+    };
+    #define NUM_AXES (int)(sizeof(axes) / sizeof(axes[0]))
+
+    // "a,b,c" and "from:step:to" (both ends included), mixed
+    bool parseValues(const juce::String& text, std::vector<float>& values)
+    {
+        for (const auto& token : juce::StringArray::fromTokens(text, ",", ""))
+        {
+            const auto range = juce::StringArray::fromTokens(token, ":", "");
+            if (range.size() == 1)
+                values.push_back(token.getFloatValue());
+            else if (range.size() == 3 && range[1].getFloatValue() > 0)
+            {
+                const float from = range[0].getFloatValue(), step = range[1].getFloatValue(), to = range[2].getFloatValue();
+                for (int k = 0; from + k * step <= to + step * 1e-3f; k++)
+                    values.push_back(from + k * step);
+            }
+            else
+                return false;
+        }
+        return !values.empty();
+    }
+
+    // Output metrics, piece by piece. The gain reduction comes from the
+    // block meters of the processor (mean gain of the block).
+    struct Metrics {
+        LoudnessMeter loudness;
+        double peak = 0, sumSquares = 0, samples = 0;
+        double grSum[4] = {}, grMax[4] = {};
+        int grActive[4] = {}, blocks = 0;
+
+        void prepare(double fs, int channels)
+        {
+            loudness.prepare(fs, channels);
+        }
+        void addAudio(const float* const* data, int channels, int n)
+        {
+            loudness.process(data, n);
+            for (int ch = 0; ch < channels; ch++)
+                for (int i = 0; i < n; i++)
+                {
+                    peak = juce::jmax(peak, (double)std::abs(data[ch][i]));
+                    sumSquares += (double)data[ch][i] * data[ch][i];
+                }
+            samples += (double)channels * n;
+        }
+        void addGains(MBComp01AudioProcessor& processor)
+        {
+            for (int band = 0; band < 4; band++)
+            {
+                const double gr = -juce::Decibels::gainToDecibels(processor.getGLvl(band), -200.0f);
+                grSum[band] += gr;
+                grMax[band] = juce::jmax(grMax[band], gr);
+                grActive[band] += gr > SWEEP_ACTIVE_GR;
+            }
+            blocks++;
+        }
+        double rms() const
+        {
+            return samples > 0 ? std::sqrt(sumSquares / samples) : 0;
+        }
+    };
+
+    // The whole input through a fresh instance with every parameter at its
+    // plain value, plus the latency in zeros; the delayed start is skipped.
+    void measure(const juce::AudioBuffer<float>& input, double fs, const std::vector<float>& values, Metrics& m)
+    {
+        const int channels = input.getNumChannels();
+        const int length = input.getNumSamples();
+
+        MBComp01AudioProcessor processor;
+        processor.setPlayConfigDetails(channels, channels, fs, SWEEP_BLOCK);
+        processor.setNonRealtime(true);
+        // both taken by prepareToPlay, no fade in
+        processor.swapPreset(values.data());
+        processor.subscribeMeters(true);
+        processor.prepareToPlay(fs, SWEEP_BLOCK);
+        const int latency = processor.getLatencySamples();
+        m.prepare(fs, channels);
+
+        juce::AudioBuffer<float> block(channels, SWEEP_BLOCK);
+        juce::MidiBuffer midi;
+        for (int pos = 0; pos < length + latency; pos += SWEEP_BLOCK)
+        {
+            const int n = juce::jmin(SWEEP_BLOCK, length + latency - pos);
+            juce::AudioBuffer<float> piece(block.getArrayOfWritePointers(), channels, n);
+            fillPiece(input, piece, pos);
+
+            processor.processBlock(piece, midi);
+            m.addGains(processor);
+
+            const int skip = juce::jlimit(0, n, latency - pos);
+            const float* out[2];
+            for (int ch = 0; ch < channels; ch++)
+                out[ch] = piece.getReadPointer(ch) + skip;
+            m.addAudio(out, channels, n - skip);
+        }
+    }
+
+    void printAudioMetrics(std::FILE* file, const Metrics& m)
+    {
+        std::fprintf(file, ",%.2f,%.2f,%.2f,%.2f", m.loudness.getIntegrated(), toDecibels(m.peak),
+            toDecibels(m.rms()), toDecibels(m.peak) - toDecibels(m.rms()));
+    }
+}
+
+int runSweepTool(const juce::StringArray& args)
+{
+    if (args.size() < 2)
+    {
+        std::printf("sweep: input and output files expected\n");
+        return 1;
+    }
+
+    juce::AudioBuffer<float> input;
+    double fs = 0;
+    if (!readAudio(juce::File::getCurrentWorkingDirectory().getChildFile(args[0]), input, fs))
+    {
+        std::printf("sweep: can't read %s\n", args[0].toRawUTF8());
+        return 1;
+    }
+    if (input.getNumChannels() > 2)
+    {
+        std::printf("sweep: mono or stereo input expected, as the plugin takes\n");
+        return 1;
+    }
+    juce::MemoryBlock state;
+    const juce::String stateFile = optionValue(args, "--state");
+    if (stateFile.isNotEmpty() && !readState(juce::File::getCurrentWorkingDirectory().getChildFile(stateFile), state))
+    {
+        std::printf("sweep: can't read the state %s\n", stateFile.toRawUTF8());
+        return 1;
+    }
+
+    // plain values of the base settings, the parameter indices
+    MBComp01AudioProcessor base;
+    if (state.getSize() > 0)
+        base.setStateInformation(state.getData(), (int)state.getSize());
+    std::vector<float> baseValues;
+    for (auto* param : base.getParameters())
+    {
+        auto* ranged = static_cast<juce::RangedAudioParameter*>(param);
+        baseValues.push_back(ranged->convertFrom0to1(ranged->getValue()));
+    }
+
+    bool bands[4] = { true, true, true, true };
+    if (hasOption(args, "--bands"))
+    {
+        const auto names = juce::StringArray::fromTokens(optionValue(args, "--bands"), ",", "");
+        for (int band = 0; band < 4; band++)
+            bands[band] = names.contains(bandNames[band]);
+    }
+
+    // the swept axes and their values, checked against the parameter ranges
+    std::vector<int> swept;
+    std::vector<float> values[NUM_AXES];
+    size_t runs = 1;
+    for (int a = 0; a < NUM_AXES; a++)
+    {
+        const juce::String option = juce::String("--") + axes[a].name;
+        if (!hasOption(args, option.toRawUTF8()))
+            continue;
+
+        const auto& range = axes[a].param(base, 0)->getNormalisableRange();
+        if (!parseValues(optionValue(args, option.toRawUTF8()), values[a]))
+        {
+            std::printf("sweep: can't read the values of %s\n", option.toRawUTF8());
+            return 1;
+        }
+        for (float v : values[a])
+            if (v < range.start || v > range.end)
+            {
+                std::printf("sweep: %s %g is out of %g..%g\n", axes[a].name, v, range.start, range.end);
+                return 1;
+            }
+        swept.push_back(a);
+        runs *= values[a].size();
+    }
+    if (runs > SWEEP_MAX_RUNS)
+    {
+        std::printf("sweep: %zu combinations, at most %d\n", runs, SWEEP_MAX_RUNS);
+        return 1;
+    }
+
+    std::FILE* csv = std::fopen(juce::File::getCurrentWorkingDirectory().getChildFile(args[1]).getFullPathName().toRawUTF8(), "w");
+    if (csv == nullptr)
+    {
+        std::printf("sweep: can't write %s\n", args[1].toRawUTF8());
+        return 1;
+    }
+    std::fprintf(csv, "index");
+    for (int a : swept)
+        std::fprintf(csv, ",%s", axes[a].name);
+    std::fprintf(csv, ",loudness_lufs,peak_dbfs,rms_dbfs,crest_db");
+    for (int band = 0; band < 4; band++)
+        std::fprintf(csv, ",gr_mean_%s,gr_max_%s,gr_active_%s", bandNames[band], bandNames[band], bandNames[band]);
+    std::fprintf(csv, "\n");
+    std::fflush(csv);
+
+    const int channels = input.getNumChannels();
+    const int threads = juce::jlimit(1, 256, optionValue(args, "--threads",
+        juce::String(juce::jmax(1, (int)std::thread::hardware_concurrency()))).getIntValue());
+
+    Metrics reference;
+    reference.prepare(fs, channels);
+    reference.addAudio(input.getArrayOfReadPointers(), channels, input.getNumSamples());
+    std::printf("%d channels, %.1f s at %g Hz, %zu combinations on %d threads\n",
+        channels, input.getNumSamples() / fs, fs, runs, threads);
+    std::printf("input: %.2f LUFS, peak %.2f dBFS, crest %.2f dB\n", reference.loudness.getIntegrated(),
+        toDecibels(reference.peak), toDecibels(reference.peak) - toDecibels(reference.rms()));
+
+    // combination k: its digits in the mixed radix of the swept value counts
+    std::mutex writing;
+    std::atomic<int> next{ 0 };
+    int done = 0;
+    auto work = [&]
+        {
+            for (int k = next++; k < (int)runs; k = next++)
+            {
+                std::vector<float> plain = baseValues;
+                std::vector<float> row;
+                int rest = k;
+                for (int a : swept)
+                {
+                    const float v = values[a][rest % values[a].size()];
+                    rest /= (int)values[a].size();
+                    row.push_back(v);
+                    for (int band = 0; band < (axes[a].perBand ? 4 : 1); band++)
+                        if (!axes[a].perBand || bands[band])
+                            plain[axes[a].param(base, band)->getParameterIndex()] = v;
+                }
+
+                Metrics m;
+                measure(input, fs, plain, m);
+
+                std::lock_guard<std::mutex> lock(writing);
+                std::fprintf(csv, "%d", k);
+                for (float v : row)
+                    std::fprintf(csv, ",%g", v);
+                printAudioMetrics(csv, m);
+                for (int band = 0; band < 4; band++)
+                    std::fprintf(csv, ",%.2f,%.2f,%.1f", m.grSum[band] / juce::jmax(1, m.blocks), m.grMax[band],
+                        100.0 * m.grActive[band] / juce::jmax(1, m.blocks));
+                std::fprintf(csv, "\n");
+                std::fflush(csv);
+                std::printf("\r%d / %zu", ++done, runs);
+                std::fflush(stdout);
+            }
+        };
+
+    const auto start = juce::Time::getHighResolutionTicks();
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; t++)
+        workers.emplace_back(work);
+    work();
+    for (auto& worker : workers)
+        worker.join();
+    const double wall = secondsSince(start);
+
+    std::fclose(csv);
+    std::printf("\n%.2f s, %.2f s per combination, %.0fx realtime over all\n",
+        wall, wall / runs, runs * input.getNumSamples() / fs / wall);
+    return 0;
+}
@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    ToolMain.cpp
+    Created: 20 Oct 2026 2:10:44am
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "Tools.h"
+
+// Offline tools around the processor. They run the plugin as it is, the
+// same instances a host would create, only without a host.
+
+//==============================================================================
+bool readAudio(const juce::File& file, juce::AudioBuffer<float>& buffer, double& sampleRate)
+{
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+    std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(file));
+    if (reader == nullptr || reader->lengthInSamples > std::numeric_limits<int>::max())
+        return false;
+
+    buffer.setSize((int)reader->numChannels, (int)reader->lengthInSamples);
+    sampleRate = reader->sampleRate;
+    return reader->read(&buffer, 0, buffer.getNumSamples(), 0, true, true);
+}
+bool writeAudio(const juce::File& file, const juce::AudioBuffer<float>& buffer, double sampleRate)
+{
+    file.deleteFile();
+    std::unique_ptr<juce::OutputStream> stream(file.createOutputStream());
+    if (stream == nullptr)
+        return false;
+
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(), sampleRate,
+        (unsigned int)buffer.getNumChannels(), 32, {}, 0));
+    if (writer == nullptr)
+        return false;
+
+    stream.release();   // the writer owns it now
+    return writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples());
+}
+bool readState(const juce::File& file, juce::MemoryBlock& state)
+{
+    if (!file.loadFileAsData(state))
+        return false;
+
+    if (state.getSize() > 0 && static_cast<const char*>(state.getData())[0] == '<')
+    {
+        auto xml = juce::parseXML(state.toString());
+        if (xml == nullptr)
+            return false;
+        state.reset();
+        juce::AudioProcessor::copyXmlToBinary(*xml, state);
+    }
+    return true;
+}
+
+//==============================================================================
+static const struct { const char* name; int (*run)(const juce::StringArray&); const char* usage; } tools[] =
+{
+    { "render", runRenderTool,
+      "<in> <out.wav> [--state file] [--threads n] [--segment seconds] [--verify] [--scaling]\n"
+      "                parallel render of a long file, segments warmed up and stitched" },
+    { "sweep",  runSweepTool,
+      "<in> <out.csv> [--state file] [--threads n] [--bands low,mid,high,master]\n"
+      "                [--CT list] [--CR list] [--at list] [--rt list] [--f0 list] [--f1 list]\n"
+      "                metrics of every parameter combination, a list is a,b,c or from:step:to" },
+};
+
+int main(int argc, char* argv[])
+{
+    const auto* tool = argc < 2 ? nullptr : std::find_if(std::begin(tools), std::end(tools),
+        [&](const auto& t) { return std::strcmp(argv[1], t.name) == 0; });
+
+    if (tool == nullptr || tool == std::end(tools))
+    {
+        if (argc >= 2)
+            std::printf("unknown tool: %s\n\n", argv[1]);
+        std::printf("usage: MBCompTool <tool> ...\n\n");
+        for (const auto& t : tools)
+            std::printf("  %-8s %s\n", t.name, t.usage);
+        return 1;
+    }
+
+    // the processors expect a message manager, no windows are opened
+    juce::ScopedJuceInitialiser_GUI gui;
+
+    juce::StringArray args;
+    for (int i = 2; i < argc; i++)
+        args.add(juce::CharPointer_UTF8(argv[i]));
+    return tool->run(args);
+}
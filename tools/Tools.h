@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+
+    Tools.h
+    Created: 20 Oct 2026 2:10:44am
+    Author:  Kozaróczy Csaba
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+
+//==============================================================================
+// every tool gets the arguments after its name and returns 0 on success
+int runRenderTool(const juce::StringArray& args);
+int runSweepTool(const juce::StringArray& args);
+
+//==============================================================================
+// ToolMain.cpp
+// whole file into memory, any format JUCE reads; false if it can't
+bool readAudio(const juce::File& file, juce::AudioBuffer<float>& buffer, double& sampleRate);
+// 32 bit float WAV
+bool writeAudio(const juce::File& file, const juce::AudioBuffer<float>& buffer, double sampleRate);
+// plugin state: the binary state of a host, or the <MBComp .../> XML of
+// getStateInformation as text
+bool readState(const juce::File& file, juce::MemoryBlock& state);
+
+//==============================================================================
+inline double secondsSince(juce::int64 startTicks)
+{
+    return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+}
+
+// value after `--name`, or the fallback if the option is missing
+inline juce::String optionValue(const juce::StringArray& args, const char* name, const juce::String& fallback = {})
+{
+    const int i = args.indexOf(name);
+    return i >= 0 && i + 1 < args.size() ? args[i + 1] : fallback;
+}
+inline bool hasOption(const juce::StringArray& args, const char* name)
+{
+    return args.contains(name);
+}
+
+// input [pos, pos + piece length) into piece, zeros past the end of the input
+inline void fillPiece(const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& piece, int pos)
+{
+    const int n = piece.getNumSamples();
+    const int valid = juce::jlimit(0, n, input.getNumSamples() - pos);
+    for (int ch = 0; ch < piece.getNumChannels(); ch++)
+    {
+        if (valid > 0)
+            piece.copyFrom(ch, 0, input, ch, pos, valid);
+        if (valid < n)
+            piece.clear(ch, valid, n - valid);
+    }
+}
+
+inline float toDecibels(double error)
+{
+    return juce::Decibels::gainToDecibels((float)error, -200.0f);
+}